@@ -0,0 +1,361 @@
+#include "fake_rclone.h"
+#include "icon_cache.h"
+#include "item_model.h"
+#include "job_widget.h"
+#include "main_window.h"
+#include "qcron.h"
+#include "utils.h"
+#include <functional>
+
+// drives Rclone Browser code with this executable acting as rclone and prints
+// timings as json, usage:
+//   rclone-browser-benchmark [--output results.json]
+
+namespace {
+
+const qint64 timeoutMs = 300000;
+
+// counts paint events of a window and all widgets inside it
+class PaintCounter : public QObject {
+public:
+  explicit PaintCounter(QWidget *window) : mWindow(window) {
+    qApp->installEventFilter(this);
+  }
+  ~PaintCounter() { qApp->removeEventFilter(this); }
+
+  int count() const { return mCount; }
+
+protected:
+  bool eventFilter(QObject *watched, QEvent *event) override {
+    if (event->type() == QEvent::Paint) {
+      QWidget *widget = qobject_cast<QWidget *>(watched);
+      if (widget != nullptr && widget->window() == mWindow) {
+        mCount++;
+      }
+    }
+    return false;
+  }
+
+private:
+  QWidget *mWindow;
+  int mCount = 0;
+};
+
+// runs event loop until condition is met, returns ms since timer start or -1
+// on timeout
+qint64 waitFor(const QElapsedTimer &timer,
+               const std::function<bool()> &condition) {
+  QTimer tick;
+  tick.start(1);
+  while (!condition()) {
+    if (timer.elapsed() > timeoutMs) {
+      return -1;
+    }
+    QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+  }
+  return timer.elapsed();
+}
+
+// settings main() creates on first run, with this executable as rclone and
+// nothing that would wait for network or user
+// written to fresh temporary config folder - never to user's settings
+void prepareSettings() {
+  auto settings = GetSettings();
+  settings->setValue("Settings/rclone", qApp->applicationFilePath());
+  settings->setValue("Settings/rcloneConf", "");
+  settings->setValue("Settings/checkRcloneUpdates", false);
+  settings->setValue("Settings/checkRcloneBrowserUpdates", false);
+  settings->setValue("Settings/darkModeIni", false);
+  settings->setValue("Settings/iconSize", "M");
+  settings->setValue("Settings/iconsLayout", "tiles");
+  settings->setValue("Settings/iconsColour", "black");
+  settings->setValue("Settings/buttonStyle", "icononly");
+  settings->setValue("Settings/fontSize", "0");
+  settings->setValue("Settings/buttonSize", "0");
+  settings->setValue("Settings/sortTask", false);
+  settings->setValue("Settings/remoteMode", "main");
+  settings->setValue("Settings/remoteType", "main");
+  settings->setValue("Settings/soundNotif", false);
+  settings->setValue("Settings/schedulerStatus", false);
+  settings->setValue("Settings/queueStatus", false);
+  settings->setValue("Settings/preemptiveLoading", false);
+  settings->setValue("Settings/showFolderIcons", true);
+  settings->setValue("Settings/showFileIcons", true);
+  settings->setValue("Settings/showHidden", true);
+  settings->setValue("Settings/queueSlots", 1);
+  settings->setValue("Settings/queueOrder", "manual");
+  settings->sync();
+
+  ReloadSettingsSnapshot();
+  SetRclone(qApp->applicationFilePath());
+  SetRcloneConf(QString());
+}
+
+// from MainWindow construction until window is painted and rclone version
+// check and remotes listing finished (startup.log written)
+QJsonObject startup(bool cold) {
+
+  QDir configDir = GetConfigDir();
+  configDir.mkpath(".");
+  configDir.remove("startup.log");
+  if (cold) {
+    configDir.remove("version.cache");
+    configDir.remove("remotes.cache");
+  }
+
+  QJsonObject result;
+  QElapsedTimer timer;
+  timer.start();
+
+  MainWindow *window = new MainWindow();
+  result.insert("construct_ms", timer.elapsed());
+
+  PaintCounter paints(window);
+  window->show();
+  result.insert("first_paint_ms",
+                waitFor(timer, [&]() { return paints.count() > 0; }));
+  result.insert("ready_ms", waitFor(timer, [&]() {
+                  return configDir.exists("startup.log");
+                }));
+
+  window->close();
+  delete window;
+  return result;
+}
+
+int findRow(ItemModel *model, const QModelIndex &parent, const QString &name) {
+  for (int i = 0; i < model->rowCount(parent); i++) {
+    if (model->index(i, 0, parent).data(Qt::DisplayRole).toString() == name) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// remote root listing painted in the tree and expansion of folder with
+// RB_BENCHMARK_ENTRIES files
+QJsonObject tree() {
+
+  QJsonObject result;
+  IconCache icons;
+  QTreeView view;
+  view.resize(800, 600);
+  view.show();
+  PaintCounter paints(&view);
+
+  QElapsedTimer timer;
+  timer.start();
+
+  ItemModel *model = new ItemModel(&icons, "bench", &view);
+  view.setModel(model);
+  QModelIndex root = model->addRoot("/", "/");
+  view.expand(root);
+
+  result.insert("root_listed_ms", waitFor(timer, [&]() {
+                  return !model->isLoading(root) &&
+                         findRow(model, root, "big") != -1;
+                }));
+  int rootPaints = paints.count();
+  result.insert("first_tree_paint_ms", waitFor(timer, [&]() {
+                  return paints.count() > rootPaints;
+                }));
+
+  QModelIndex big = model->index(findRow(model, root, "big"), 0, root);
+  long entries = qEnvironmentVariableIntValue("RB_BENCHMARK_ENTRIES");
+  if (entries <= 0) {
+    entries = 100000;
+  }
+  result.insert("entries", qint64(entries));
+
+  timer.restart();
+  view.expand(big);
+  result.insert("expand_listed_ms", waitFor(timer, [&]() {
+                  return !model->isLoading(big) &&
+                         model->rowCount(big) >= entries;
+                }));
+  int bigPaints = paints.count();
+  result.insert("expand_paint_ms", waitFor(timer, [&]() {
+                  return paints.count() > bigPaints;
+                }));
+
+  // icon lookup views do for every painted row
+  timer.restart();
+  int rows = model->rowCount(big);
+  for (int i = 0; i < rows; i++) {
+    model->index(i, 0, big).data(Qt::DecorationRole);
+  }
+  result.insert("decoration_ms", timer.elapsed());
+
+  // scrolling through the expanded folder page by page
+  const int pages = 200;
+  timer.restart();
+  for (int i = 0; i < pages; i++) {
+    view.scrollTo(model->index(qint64(rows - 1) * i / (pages - 1), 0, big));
+    view.viewport()->repaint();
+  }
+  result.insert("scroll_paint_ms", timer.elapsed());
+
+  return result;
+}
+
+// JobWidget reading rclone stats output as fast as fake rclone prints it
+QJsonObject progress() {
+
+  QJsonObject result;
+  long blocks = qEnvironmentVariableIntValue("RB_BENCHMARK_STATS");
+  if (blocks <= 0) {
+    blocks = 20000;
+  }
+  // lines printed by fake rclone for every stats block
+  qint64 lines = qint64(blocks) * 8;
+
+  QStringList args = QStringList() << "copy"
+                                   << "bench:/big"
+                                   << "/benchmark"
+                                   << "--stats"
+                                   << "1s";
+  QProcess *process = new QProcess();
+  process->setProcessChannelMode(QProcess::MergedChannels);
+  JobWidget *widget =
+      new JobWidget(process, "benchmark", args, "bench:/big", "/benchmark",
+                    QUuid::createUuid().toString(), "transfer",
+                    QUuid::createUuid().toString());
+  process->setParent(widget);
+
+  bool finished = false;
+  QObject::connect(widget, &JobWidget::finished,
+                   [&]() { finished = true; });
+
+  QElapsedTimer timer;
+  timer.start();
+  process->start(GetRclone(), args, QIODevice::ReadOnly);
+
+  qint64 elapsed = waitFor(timer, [&]() { return finished; });
+  result.insert("lines", lines);
+  result.insert("parse_ms", elapsed);
+  if (elapsed > 0) {
+    result.insert("lines_per_sec", lines * 1000 / elapsed);
+  }
+
+  delete widget;
+  return result;
+}
+
+// compiling cron patterns and computing their next run times
+QJsonObject cron() {
+
+  const int patterns = 5000;
+  const int runs = 10;
+  const char *weekdays[] = {"*", "1-5", "6,7", "1"};
+
+  QJsonObject result;
+  QList<QCron *> crons;
+  QElapsedTimer timer;
+  timer.start();
+
+  for (int i = 0; i < patterns; i++) {
+    QString pattern = QString("%1,%2 %3-%4 %5 %6 %7 *")
+                          .arg(i % 60)
+                          .arg((i * 7 + 30) % 60)
+                          .arg(i % 12)
+                          .arg(12 + i % 12)
+                          .arg(i % 3 == 0 ? QString("*/2") : QString("*"))
+                          .arg(i % 5 == 0 ? QString::number(1 + i % 12)
+                                          : QString("*"))
+                          .arg(weekdays[i % 4]);
+    crons << new QCron(pattern);
+  }
+  result.insert("patterns", patterns);
+  result.insert("compile_ms", timer.elapsed());
+
+  QDateTime start(QDate(2021, 1, 1), QTime(12, 0));
+  int valid = 0;
+  timer.restart();
+  for (QCron *compiled : crons) {
+    QDateTime next = start;
+    for (int i = 0; i < runs && next.isValid(); i++) {
+      next = compiled->next(next);
+    }
+    if (next.isValid()) {
+      valid++;
+    }
+  }
+  result.insert("next_runs", patterns * runs);
+  result.insert("next_ms", timer.elapsed());
+  result.insert("valid", valid);
+
+  // what scheduler calendar computes for all schedulers
+  qint64 calendarRuns = 0;
+  timer.restart();
+  for (QCron *compiled : crons) {
+    calendarRuns +=
+        compiled->next(start, 30 * 24 * 60, start.addDays(30)).count();
+  }
+  result.insert("calendar_runs", calendarRuns);
+  result.insert("calendar_ms", timer.elapsed());
+
+  qDeleteAll(crons);
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+
+  // started by benchmark below as rclone
+  if (qEnvironmentVariableIsSet("RB_BENCHMARK_FAKE_RCLONE")) {
+    return RunFakeRclone(argc, argv);
+  }
+
+  QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedKingdom));
+
+  QApplication app(argc, argv);
+  app.setApplicationName("rclone-browser-benchmark");
+  app.setOrganizationName("rclone-browser-benchmark");
+
+  // settings and config files live in temporary folder removed at exit, user's
+  // ones are never touched (portable mode ini path is fixed and would be
+  // shared otherwise)
+  QTemporaryDir configDir;
+  if (!configDir.isValid()) {
+    return 1;
+  }
+  QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope,
+                     configDir.path());
+  QSettings::setPath(QSettings::IniFormat, QSettings::UserScope,
+                     configDir.path());
+  SetConfigDirOverride(configDir.path());
+
+  QString outputFile;
+  int outputIndex = app.arguments().indexOf("--output");
+  if (outputIndex != -1 && outputIndex + 1 < app.arguments().count()) {
+    outputFile = app.arguments().at(outputIndex + 1);
+  }
+
+  qputenv("RB_BENCHMARK_FAKE_RCLONE", "1");
+  prepareSettings();
+
+  QJsonObject results;
+  results.insert("version", RCLONE_BROWSER_VERSION);
+  results.insert("cold_start", startup(true));
+  results.insert("warm_start", startup(false));
+  results.insert("tree", tree());
+  results.insert("progress", progress());
+  results.insert("cron", cron());
+
+  QByteArray json = QJsonDocument(results).toJson();
+
+  if (outputFile.isEmpty()) {
+    QTextStream(stdout) << json;
+  } else {
+    QSaveFile file(outputFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+      return 1;
+    }
+    file.write(json);
+    if (!file.commit()) {
+      return 1;
+    }
+  }
+  return 0;
+}
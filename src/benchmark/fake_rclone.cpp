@@ -0,0 +1,199 @@
+#include "fake_rclone.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+// folders and files in root of the fake remote
+const int rootEntries = 100;
+
+const char *extensions[] = {"txt", "jpg", "pdf", "mp4", "zip", "docx"};
+
+long envValue(const char *name, long def) {
+  const char *value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return def;
+  }
+  return std::strtol(value, nullptr, 10);
+}
+
+class Output {
+public:
+  Output() : mDelay(envValue("RB_BENCHMARK_DELAY", 0)) {}
+
+  void line(const std::string &text) {
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    std::fputc('\n', stdout);
+
+    if (mDelay > 0 && ++mLines % 1000 == 0) {
+      std::fflush(stdout);
+      std::this_thread::sleep_for(std::chrono::milliseconds(mDelay));
+    }
+  }
+
+private:
+  long mDelay;
+  long mLines = 0;
+};
+
+std::string fileName(long i) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "file%06ld.%s", i,
+                extensions[i % (sizeof(extensions) / sizeof(*extensions))]);
+  return name;
+}
+
+std::string folderName(long i) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "dir%04ld", i);
+  return name;
+}
+
+// folder part of "remote:path" argument without surrounding slashes
+std::string folderArg(int argc, char *argv[]) {
+  std::string path = argv[argc - 1];
+  size_t colon = path.find(':');
+  if (colon != std::string::npos) {
+    path = path.substr(colon + 1);
+  }
+  while (!path.empty() && path.front() == '/') {
+    path.erase(0, 1);
+  }
+  while (!path.empty() && path.back() == '/') {
+    path.pop_back();
+  }
+  return path;
+}
+
+long filesCount(const std::string &folder) {
+  if (folder.empty()) {
+    return rootEntries;
+  }
+  if (folder == "big") {
+    return envValue("RB_BENCHMARK_ENTRIES", 100000);
+  }
+  return 0;
+}
+
+long foldersCount(const std::string &folder) {
+  return folder.empty() ? rootEntries : 0;
+}
+
+void lsd(const std::string &folder) {
+  Output out;
+  char text[128];
+  if (folder.empty()) {
+    out.line("          -1 2021-01-01 12:00:00        -1 big");
+  }
+  for (long i = 0; i < foldersCount(folder); i++) {
+    std::snprintf(text, sizeof(text),
+                  "          -1 2021-01-01 12:00:00        -1 %s",
+                  folderName(i).c_str());
+    out.line(text);
+  }
+}
+
+void lsl(const std::string &folder) {
+  Output out;
+  char text[128];
+  for (long i = 0; i < filesCount(folder); i++) {
+    std::snprintf(text, sizeof(text), "%9ld 2021-01-01 12:00:00.000000000 %s",
+                  (i * 7919) % 100000000, fileName(i).c_str());
+    out.line(text);
+  }
+}
+
+void lsjson(const std::string &folder) {
+  Output out;
+  char text[256];
+  out.line("[");
+  bool first = true;
+  auto entry = [&](const std::string &name, long size, bool isDir) {
+    std::snprintf(text, sizeof(text),
+                  "%s{\"Path\":\"%s\",\"Name\":\"%s\",\"Size\":%ld,"
+                  "\"MimeType\":\"%s\",\"ModTime\":\"2021-01-01T12:00:00Z\","
+                  "\"IsDir\":%s}",
+                  first ? "" : ",", name.c_str(), name.c_str(), size,
+                  isDir ? "inode/directory" : "application/octet-stream",
+                  isDir ? "true" : "false");
+    first = false;
+    out.line(text);
+  };
+  if (folder.empty()) {
+    entry("big", -1, true);
+  }
+  for (long i = 0; i < foldersCount(folder); i++) {
+    entry(folderName(i), -1, true);
+  }
+  for (long i = 0; i < filesCount(folder); i++) {
+    entry(fileName(i), (i * 7919) % 100000000, false);
+  }
+  out.line("]");
+}
+
+// stats blocks in rclone 1.57 format
+void transfer() {
+  Output out;
+  char text[256];
+  long blocks = envValue("RB_BENCHMARK_STATS", 20000);
+  for (long i = 0; i < blocks; i++) {
+    long percent = blocks > 1 ? i * 100 / (blocks - 1) : 100;
+    std::snprintf(text, sizeof(text),
+                  "Transferred:   \t  %ld.000 MiB / 100.000 MiB, %ld%%, "
+                  "10.000 MiB/s, ETA %lds",
+                  percent, percent, (100 - percent) / 10);
+    out.line(text);
+    out.line("Errors:                 0");
+    out.line("Checks:                 0 / 0, -");
+    std::snprintf(text, sizeof(text),
+                  "Transferred:            %ld / 100, %ld%%", percent, percent);
+    out.line(text);
+    std::snprintf(text, sizeof(text), "Elapsed time:        %ld.0s", i);
+    out.line(text);
+    out.line("Transferring:");
+    std::snprintf(text, sizeof(text),
+                  " *                              %s: %ld%% /10Mi, "
+                  "1.000Mi/s, %lds",
+                  fileName(i % 100).c_str(), percent, (100 - percent) / 10);
+    out.line(text);
+    out.line("");
+  }
+}
+
+} // namespace
+
+int RunFakeRclone(int argc, char *argv[]) {
+
+  if (argc < 2) {
+    return 1;
+  }
+
+  std::string command = argv[1];
+
+  if (command == "version") {
+    Output out;
+    out.line("rclone v1.57.0");
+    out.line("- os/version: benchmark");
+    out.line("- os/kernel: benchmark");
+    out.line("- os/type: benchmark");
+    out.line("- os/arch: amd64");
+    out.line("- go/version: go1.17.2");
+  } else if (command == "listremotes") {
+    Output out;
+    out.line("bench: local");
+  } else if (command == "lsd") {
+    lsd(folderArg(argc, argv));
+  } else if (command == "lsl") {
+    lsl(folderArg(argc, argv));
+  } else if (command == "lsjson") {
+    lsjson(folderArg(argc, argv));
+  } else {
+    transfer();
+  }
+
+  std::fflush(stdout);
+  return 0;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// rclone stand-in used by benchmark - it answers version, listremotes, lsd,
+// lsl and lsjson with synthetic listings and any other command with stats
+// output, sizes and speed are set by environment variables:
+//   RB_BENCHMARK_ENTRIES - number of files in "big" folder (100000)
+//   RB_BENCHMARK_STATS   - number of stats blocks printed by transfer (20000)
+//   RB_BENCHMARK_DELAY   - ms to sleep after every 1000 lines (0)
+int RunFakeRclone(int argc, char *argv[]);
@@ -82,12 +82,7 @@ QStringList DedupeDialog::getOptions() const {
 
   QString extra = ui.textExtra->text().trimmed();
   if (!extra.isEmpty()) {
-    for (QString arg :
-         extra.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-      if (!arg.isEmpty()) {
-        list << arg.replace("\"", "");
-      }
-    }
+    list << SplitCommandLine(extra);
   }
 
   list << mTarget;
@@ -0,0 +1,97 @@
+#include "deferred_file_writer.h"
+
+namespace {
+class WriteTask : public QRunnable {
+public:
+  explicit WriteTask(std::function<void()> task) : mTask(task) {}
+  void run() override { mTask(); }
+
+private:
+  std::function<void()> mTask;
+};
+} // namespace
+
+DeferredFileWriter::DeferredFileWriter(const QString &filePath,
+                                       std::function<QByteArray()> content,
+                                       int delay, QObject *parent)
+    : QObject(parent), mFilePath(filePath), mContent(content) {
+
+  mPool.setMaxThreadCount(1);
+
+  mTimer.setSingleShot(true);
+  mTimer.setInterval(delay);
+
+  QObject::connect(&mTimer, &QTimer::timeout, this, [=]() { writeLater(); });
+}
+
+DeferredFileWriter::~DeferredFileWriter() {
+  flush();
+  mPool.waitForDone();
+}
+
+void DeferredFileWriter::schedule() {
+  mPending = true;
+  if (!mTimer.isActive()) {
+    mTimer.start();
+  }
+}
+
+bool DeferredFileWriter::flush() {
+  mTimer.stop();
+
+  if (!mPending) {
+    // wait for write which might be still in progress
+    mPool.waitForDone();
+    return true;
+  }
+
+  mPending = false;
+  return write(mContent(), ++mGeneration);
+}
+
+void DeferredFileWriter::writeLater() {
+  if (!mPending) {
+    return;
+  }
+  mPending = false;
+
+  QByteArray data = mContent();
+  quint64 generation = ++mGeneration;
+
+  mPool.start(
+      new WriteTask([=]() { write(data, generation); }));
+}
+
+bool DeferredFileWriter::write(const QByteArray &data, quint64 generation) {
+  QMutexLocker locker(&mWriteMutex);
+
+  if (generation <= mWrittenGeneration) {
+    return true;
+  }
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 1, 0)
+  QFile file(mFilePath);
+#else
+  QSaveFile file(mFilePath);
+#endif
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  if (file.write(data) != data.size()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+    file.cancelWriting();
+#endif
+    return false;
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+  if (!file.commit()) {
+    return false;
+  }
+#endif
+
+  mWrittenGeneration = generation;
+  return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "pch.h"
+#include <functional>
+
+// write-behind saving of small config files
+// changes requested within delay are coalesced into one write, content is
+// taken on the GUI thread and written atomically on a worker thread
+class DeferredFileWriter : public QObject {
+  Q_OBJECT
+
+public:
+  DeferredFileWriter(const QString &filePath,
+                     std::function<QByteArray()> content, int delay = 500,
+                     QObject *parent = nullptr);
+  ~DeferredFileWriter();
+
+  // request write of current content
+  void schedule();
+  // write pending changes now and wait till file is saved
+  bool flush();
+
+private:
+  QString mFilePath;
+  std::function<QByteArray()> mContent;
+  QTimer mTimer;
+  bool mPending = false;
+
+  // one worker thread, older content never overwrites newer one
+  QThreadPool mPool;
+  QMutex mWriteMutex;
+  quint64 mGeneration = 0;
+  quint64 mWrittenGeneration = 0;
+
+  void writeLater();
+  bool write(const QByteArray &data, quint64 generation);
+};
@@ -8,6 +8,9 @@ public:
   // global count of lsl/lsd rclone proecesses
   int rcloneLsProcessCount = 0;
 
+  // global count of local folders watched for changes
+  int watchedFolders = 0;
+
 public:
   Global() = default;
   Global(const Global &) = delete;
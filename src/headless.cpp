@@ -0,0 +1,813 @@
+#include "headless.h"
+#include "deferred_file_writer.h"
+#include "job_history.h"
+#include "list_of_job_options.h"
+#include "qcron.h"
+#include "queue_policy.h"
+#include "scheduler_widget.h"
+#include "utils.h"
+#ifndef Q_OS_WIN
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char *timeFormat = "ddd, dd/MMM/yyyy HH:mm:ss t";
+
+// transfers which don't stop after quit are killed
+const int killTimeoutMs = 10000;
+
+QString decoded(const QString &value) {
+  return QString::fromUtf8(QByteArray::fromBase64(value.toUtf8()));
+}
+
+QString encoded(const QString &value) {
+  return QString::fromLatin1(value.toUtf8().toBase64());
+}
+
+// per user and config so portable instances don't see each other
+QString getServerName() {
+#ifdef Q_OS_WIN
+  return "rclone-browser-headless-" +
+         QString::fromLatin1(QCryptographicHash::hash(
+                                 GetConfigDir().absolutePath().toUtf8(),
+                                 QCryptographicHash::Sha1)
+                                 .toHex()
+                                 .left(16));
+#else
+  return GetConfigDir().absoluteFilePath("headless.socket");
+#endif
+}
+
+#ifdef Q_OS_WIN
+// executable is built as GUI application without console, use console of
+// command prompt it was started from (if any) for output and Ctrl+C
+// note: interactive cmd doesn't wait for GUI application, exit code of
+// --control is available in batch files or with "start /wait"
+void attachParentConsole() {
+  if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+    FILE *stream = nullptr;
+    freopen_s(&stream, "CONOUT$", "w", stdout);
+    freopen_s(&stream, "CONOUT$", "w", stderr);
+  }
+}
+
+HeadlessService *signalService = nullptr;
+
+// called on its own thread
+BOOL WINAPI consoleCtrlHandler(DWORD type) {
+  if (signalService != nullptr &&
+      (type == CTRL_C_EVENT || type == CTRL_BREAK_EVENT)) {
+    QMetaObject::invokeMethod(signalService, "quit", Qt::QueuedConnection);
+    return TRUE;
+  }
+  return FALSE;
+}
+#else
+// signal handler only writes to socket, notifier reads it in event loop
+int signalFds[2] = {-1, -1};
+
+void signalHandler(int) {
+  char c = 1;
+  ssize_t written = ::write(signalFds[0], &c, sizeof(c));
+  (void)written;
+}
+#endif
+
+} // namespace
+
+HeadlessScheduler::HeadlessScheduler(const QStringList &args, QObject *parent)
+    : QObject(parent), mArgs(args) {
+
+  // run interrupted when previous instance quit
+  QString status = getLastRunStatus();
+  if (status == "in the queue" || status == "running") {
+    setValue("mLastRunStatus", encoded("unknown"));
+  }
+
+  updateNextRun();
+}
+
+HeadlessScheduler::~HeadlessScheduler() {
+  SchedulerService::getInstance()->unschedule(this);
+}
+
+QString HeadlessScheduler::value(const QString &key) const {
+  for (int i = 0; i + 1 < mArgs.count(); i = i + 2) {
+    if (mArgs.at(i) == key) {
+      return mArgs.at(i + 1);
+    }
+  }
+  return QString();
+}
+
+void HeadlessScheduler::setValue(const QString &key, const QString &value) {
+  for (int i = 0; i + 1 < mArgs.count(); i = i + 2) {
+    if (mArgs.at(i) == key) {
+      mArgs[i + 1] = value;
+      return;
+    }
+  }
+  mArgs << key << value;
+}
+
+QString HeadlessScheduler::getName() const {
+  return decoded(value("mSchedulerName"));
+}
+
+QString HeadlessScheduler::getLastRunStatus() const {
+  return decoded(value("mLastRunStatus"));
+}
+
+bool HeadlessScheduler::isActive() const {
+  return value("mSchedulerStatus") == "activated";
+}
+
+bool HeadlessScheduler::isDailyRunDay(int dayOfWeek) const {
+  static const char *days[] = {"mDailyMon", "mDailyTue", "mDailyWed",
+                               "mDailyThu", "mDailyFri", "mDailySat",
+                               "mDailySun"};
+  return dayOfWeek >= 1 && dayOfWeek <= 7 &&
+         QVariant(value(days[dayOfWeek - 1])).toBool();
+}
+
+// the same rules as SchedulerWidget::nextRun
+void HeadlessScheduler::updateNextRun(bool fromLastRun) {
+
+  qint64 jitter = SchedulerService::getJitter(value("mSchedulerId"));
+  QDateTime now = QDateTime::currentDateTime();
+  // counted from the last run time, see SchedulerWidget::updateNextRun
+  if (fromLastRun && mNextRun.isValid()) {
+    now = qMax(mNextRun, now.addMSecs(-jitter));
+  }
+  mNextRun = QDateTime();
+
+  if (QVariant(value("mCronState")).toBool()) {
+    if (!mCron) {
+      QString cronExp =
+          SchedulerWidget::enhanceCron(decoded(value("mCron")).trimmed()) +
+          " *";
+      mCron.reset(new QCron(cronExp));
+    }
+    mNextRun = mCron->next(now);
+  } else if (QVariant(value("mDailyState")).toBool()) {
+    QTime time(value("mDailyHour").toInt(), value("mDailyMinute").toInt());
+    for (int i = 0; i <= 7 && !mNextRun.isValid(); i++) {
+      QDateTime dt(now.date().addDays(i), time);
+      if (isDailyRunDay(dt.date().dayOfWeek()) && dt > now) {
+        mNextRun = dt;
+      }
+    }
+  }
+
+  if (mNextRun.isValid()) {
+    SchedulerService::getInstance()->schedule(this, mNextRun.addMSecs(jitter));
+  }
+}
+
+void HeadlessScheduler::runSchedule(bool run) {
+  updateNextRun(true);
+  if (run) {
+    emit runTask();
+  }
+}
+
+QString HeadlessScheduler::startRequest() {
+  QString requestId = QUuid::createUuid().toString();
+  setValue("mRequestId", requestId);
+  return requestId;
+}
+
+void HeadlessScheduler::setStatus(const QString &status) {
+
+  QString now = QDateTime::currentDateTime().toString(timeFormat);
+
+  if (status == "running" || status == "in the queue") {
+    setValue("mLastRun", encoded(now));
+    setValue("mLastRunFinished", encoded(""));
+  } else if (status == "task already running" ||
+             status == "task already in the queue") {
+    setValue("mLastRun", encoded(now));
+    setValue("mLastRunFinished", encoded(now));
+  } else {
+    setValue("mLastRunFinished", encoded(now));
+  }
+  setValue("mLastRunStatus", encoded(status));
+}
+
+HeadlessService::HeadlessService(QObject *parent) : QObject(parent) {
+
+  mQueueFileWriter =
+      new DeferredFileWriter(GetConfigDir().absoluteFilePath("queue.conf"),
+                             [=]() { return getQueueFileContent(); }, 500, this);
+  mSchedulerFileWriter = new DeferredFileWriter(
+      GetConfigDir().absoluteFilePath("scheduler.conf"),
+      [=]() { return getSchedulerFileContent(); }, 500, this);
+
+  QObject::connect(&mServer, &QLocalServer::newConnection, this, [=]() {
+    while (QLocalSocket *socket = mServer.nextPendingConnection()) {
+      QObject::connect(socket, &QLocalSocket::disconnected, socket,
+                       &QLocalSocket::deleteLater);
+      QObject::connect(socket, &QLocalSocket::readyRead, this, [=]() {
+        if (!socket->canReadLine()) {
+          return;
+        }
+        QString line = QString::fromUtf8(socket->readLine()).trimmed();
+        socket->write(command(line).toUtf8());
+        socket->disconnectFromServer();
+      });
+    }
+  });
+}
+
+HeadlessService::~HeadlessService() {
+#ifdef Q_OS_WIN
+  SetConsoleCtrlHandler(consoleCtrlHandler, FALSE);
+  signalService = nullptr;
+#endif
+
+  // writers read schedulers and queue so they have to go first
+  delete mQueueFileWriter;
+  delete mSchedulerFileWriter;
+}
+
+bool HeadlessService::start() {
+
+  auto settings = GetSettings();
+  SetRclone(settings->value("Settings/rclone").toString());
+  SetRcloneConf(settings->value("Settings/rcloneConf").toString());
+  mQueueStatus = settings->value("Settings/queueStatus").toBool();
+
+  // socket left behind by crashed instance
+  QLocalServer::removeServer(getServerName());
+  mServer.setSocketOptions(QLocalServer::UserAccessOption);
+  if (!mServer.listen(getServerName())) {
+    qCritical("Can't create control socket %s: %s",
+              qPrintable(getServerName()), qPrintable(mServer.errorString()));
+    return false;
+  }
+
+  installSignalHandlers();
+  loadSchedulers();
+  loadQueue();
+  runQueue();
+  return true;
+}
+
+// SIGTERM/SIGINT (Ctrl+C on Windows) stop transfers like quit command
+// instead of killing the instance with rclone processes left running
+void HeadlessService::installSignalHandlers() {
+#ifdef Q_OS_WIN
+  attachParentConsole();
+  signalService = this;
+  SetConsoleCtrlHandler(consoleCtrlHandler, TRUE);
+#else
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) != 0) {
+    qWarning("Can't create signal socket pair, signals are not handled");
+    return;
+  }
+
+  mSignalNotifier =
+      new QSocketNotifier(signalFds[1], QSocketNotifier::Read, this);
+  QObject::connect(mSignalNotifier, SIGNAL(activated(int)), this,
+                   SLOT(handleSignal()));
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = signalHandler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGTERM, &action, nullptr);
+  sigaction(SIGINT, &action, nullptr);
+#endif
+}
+
+void HeadlessService::handleSignal() {
+#ifndef Q_OS_WIN
+  char c;
+  ssize_t received = ::read(signalFds[1], &c, sizeof(c));
+  (void)received;
+#endif
+  quit();
+}
+
+void HeadlessService::loadSchedulers() {
+
+  QFile file(GetConfigDir().absoluteFilePath("scheduler.conf"));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QTextStream in(&file);
+  while (!in.atEnd()) {
+    QStringList args = in.readLine().split(",");
+    auto scheduler = new HeadlessScheduler(args, this);
+
+    // kept even without task so scheduler.conf is saved unchanged
+    mSchedulers << scheduler;
+    QObject::connect(scheduler, &HeadlessScheduler::runTask, this,
+                     [=]() { scheduledRun(scheduler); });
+  }
+}
+
+void HeadlessService::loadQueue() {
+
+  QFile file(GetConfigDir().absoluteFilePath("queue.conf"));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  ListOfJobOptions *ljo = ListOfJobOptions::getInstance();
+  QTextStream in(&file);
+  while (!in.atEnd()) {
+    // taskId[,requestId[,requestId of task it has to wait for]]
+    QStringList fields = in.readLine().split(",");
+
+    QueueEntry entry;
+    entry.taskId = fields.at(0);
+    entry.requestId =
+        fields.count() > 1 ? fields.at(1) : QUuid::createUuid().toString();
+    entry.dependsOn = fields.count() > 2 ? fields.at(2) : QString();
+
+    if (ljo->getTask(entry.taskId) != nullptr) {
+      mQueue << entry;
+    }
+
+    HeadlessScheduler *scheduler = getScheduler(entry.requestId);
+    if (scheduler != nullptr) {
+      scheduler->setStatus("in the queue");
+    }
+  }
+}
+
+QByteArray HeadlessService::getQueueFileContent() {
+
+  QByteArray data;
+  for (const QueueEntry &entry : mQueue) {
+    data += entry.taskId.toUtf8() + "," + entry.requestId.toUtf8();
+    if (!entry.dependsOn.isEmpty()) {
+      data += "," + entry.dependsOn.toUtf8();
+    }
+    data += "\n";
+  }
+  return data;
+}
+
+QByteArray HeadlessService::getSchedulerFileContent() {
+
+  QByteArray data;
+  for (HeadlessScheduler *scheduler : mSchedulers) {
+    data += scheduler->getArgs().join(",").toUtf8() + "\n";
+  }
+  return data;
+}
+
+HeadlessScheduler *HeadlessService::getScheduler(const QString &requestId) {
+  for (HeadlessScheduler *scheduler : mSchedulers) {
+    if (scheduler->getRequestId() == requestId) {
+      return scheduler;
+    }
+  }
+  return nullptr;
+}
+
+void HeadlessService::scheduledRun(HeadlessScheduler *scheduler) {
+
+  JobOptions *jo = ListOfJobOptions::getInstance()->getTask(
+      scheduler->getTaskId());
+
+  if (mQuitting || jo == nullptr || !scheduler->isActive() ||
+      !GetSettingsSnapshot()->value("Settings/schedulerStatus").toBool()) {
+    return;
+  }
+
+  // previous run still in progress
+  QString lastStatus = scheduler->getLastRunStatus();
+  if (lastStatus == "running" || lastStatus == "in the queue") {
+    return;
+  }
+
+  QString requestId = scheduler->startRequest();
+
+  // remote already has enough running transfers - wait in the queue ahead of
+  // other tasks (only when queue runs, otherwise it would never start), the
+  // same as MainWindow
+  bool priority = false;
+  if (!scheduler->isQueued() && mQueueStatus &&
+      isRemoteBusy(
+          GetTaskRemotes(jo),
+          GetSettingsSnapshot()->value("Settings/schedulerRemoteCap").toInt())) {
+    priority = true;
+  }
+
+  if (scheduler->isQueued() || priority) {
+    for (const QueueEntry &entry : mQueue) {
+      if (entry.taskId == scheduler->getTaskId()) {
+        scheduler->setStatus("task already in the queue");
+        mSchedulerFileWriter->schedule();
+        return;
+      }
+    }
+
+    QueueEntry entry;
+    entry.taskId = scheduler->getTaskId();
+    entry.requestId = requestId;
+    if (priority) {
+      entry.priority = true;
+      mQueue.insert(getQueuePriorityRow(), entry);
+    } else {
+      mQueue << entry;
+    }
+    scheduler->setStatus("in the queue");
+    mQueueFileWriter->schedule();
+    runQueue();
+  } else if (startTask(jo, requestId, "scheduler")) {
+    scheduler->setStatus("running");
+  } else {
+    scheduler->setStatus("task already running");
+  }
+
+  mSchedulerFileWriter->schedule();
+}
+
+// start waiting tasks while there are free slots, the same limits as
+// MainWindow::runQueue
+// running tasks are moved to the top of the queue
+void HeadlessService::runQueue() {
+
+  orderQueue();
+
+  if (!mQueueStatus || mQuitting) {
+    return;
+  }
+
+  auto settings = GetSettingsSnapshot();
+  int slots = qMax(1, settings->value("Settings/queueSlots", 1).toInt());
+  int remoteCap = settings->value("Settings/queueRemoteCap", 0).toInt();
+  ListOfJobOptions *ljo = ListOfJobOptions::getInstance();
+  int runningCount = getQueueRunningCount();
+
+  QSet<QString> queuedRequests;
+  QHash<QString, int> remotesUsage;
+  for (const QueueEntry &entry : mQueue) {
+    queuedRequests.insert(entry.requestId);
+    JobOptions *jo = ljo->getTask(entry.taskId);
+    if (entry.running && jo != nullptr) {
+      for (const QString &remote : GetTaskRemotes(jo)) {
+        remotesUsage[remote]++;
+      }
+    }
+  }
+
+  for (int i = runningCount; i < mQueue.count() && mRunning.count() < slots;
+       i++) {
+    QueueEntry &entry = mQueue[i];
+    JobOptions *jo = ljo->getTask(entry.taskId);
+
+    // wait until task it depends on leaves the queue
+    if (jo == nullptr || (!entry.dependsOn.isEmpty() &&
+                          queuedRequests.contains(entry.dependsOn))) {
+      continue;
+    }
+
+    QStringList remotes = GetTaskRemotes(jo);
+    if (IsRemoteBusy(remotes, remotesUsage, remoteCap) ||
+        !startTask(jo, entry.requestId, "queue")) {
+      continue;
+    }
+
+    entry.running = true;
+    for (const QString &remote : remotes) {
+      remotesUsage[remote]++;
+    }
+
+    HeadlessScheduler *scheduler = getScheduler(entry.requestId);
+    if (scheduler != nullptr) {
+      scheduler->setStatus("running");
+      mSchedulerFileWriter->schedule();
+    }
+
+    mQueue.move(i, runningCount);
+    ++runningCount;
+    mQueueFileWriter->schedule();
+  }
+}
+
+// running tasks are at the top of the queue
+int HeadlessService::getQueueRunningCount() {
+  int count = 0;
+  while (count < mQueue.count() && mQueue.at(count).running) {
+    count++;
+  }
+  return count;
+}
+
+// estimated seconds left for running queue tasks, 0 when not known
+QList<qint64> HeadlessService::getQueueRunningRemaining() {
+
+  QHash<QString, qint64> estimates =
+      JobHistory::getInstance()->getEstimatedDurations();
+  QDateTime now = QDateTime::currentDateTime();
+  QList<qint64> remaining;
+
+  for (int i = 0; i < getQueueRunningCount(); i++) {
+    const QueueEntry &entry = mQueue.at(i);
+    QProcess *process = mRunning.value(entry.requestId, nullptr);
+    qint64 elapsed =
+        process != nullptr
+            ? process->property("started").toDateTime().secsTo(now)
+            : 0;
+    remaining << qMax<qint64>(0, estimates.value(entry.taskId, 0) - elapsed);
+  }
+  return remaining;
+}
+
+// reorder waiting tasks, the same rules as MainWindow uses
+void HeadlessService::orderQueue() {
+
+  int runningCount = getQueueRunningCount();
+  if (mQueue.count() - runningCount < 2) {
+    return;
+  }
+
+  QList<QueuedTask> tasks;
+  for (int i = runningCount; i < mQueue.count(); i++) {
+    QueuedTask task;
+    task.taskId = mQueue.at(i).taskId;
+    task.priority = mQueue.at(i).priority;
+    tasks << task;
+  }
+
+  QList<int> order = GetQueueOrder(tasks, getQueueRunningRemaining());
+
+  QList<QueueEntry> ordered = mQueue.mid(0, runningCount);
+  bool changed = false;
+  for (int i = 0; i < order.count(); i++) {
+    ordered << mQueue.at(runningCount + order.at(i));
+    changed = changed || order.at(i) != i;
+  }
+
+  if (changed) {
+    mQueue = ordered;
+    mQueueFileWriter->schedule();
+  }
+}
+
+// row behind running and other priority tasks
+int HeadlessService::getQueuePriorityRow() {
+
+  QList<bool> ahead;
+  for (const QueueEntry &entry : mQueue) {
+    ahead << (entry.running || entry.priority);
+  }
+  return GetQueuePriorityRow(ahead);
+}
+
+// true if any of remotes is used by at least cap running transfers,
+// transfers started outside of the queue are counted as well
+bool HeadlessService::isRemoteBusy(const QStringList &remotes, int cap) {
+
+  ListOfJobOptions *ljo = ListOfJobOptions::getInstance();
+  QHash<QString, int> remotesUsage;
+  for (QProcess *process : mRunning) {
+    JobOptions *jo = ljo->getTask(process->property("taskId").toString());
+    if (jo != nullptr) {
+      for (const QString &remote : GetTaskRemotes(jo)) {
+        remotesUsage[remote]++;
+      }
+    }
+  }
+
+  return IsRemoteBusy(remotes, remotesUsage, cap);
+}
+
+// false if the same task is already running
+bool HeadlessService::startTask(JobOptions *jo, const QString &requestId,
+                                const QString &transferMode) {
+
+  for (QProcess *process : mRunning) {
+    if (process->property("taskId").toString() == jo->uniqueId.toString()) {
+      return false;
+    }
+  }
+
+  jo->dryRun = false;
+
+  QProcess *process = new QProcess(this);
+  // output is only shown by JobWidget
+  process->setProcessChannelMode(QProcess::MergedChannels);
+  process->setStandardOutputFile(QProcess::nullDevice());
+  process->setProperty("taskId", jo->uniqueId.toString());
+  process->setProperty("started", QDateTime::currentDateTime());
+  mRunning.insert(requestId, process);
+
+  JobHistoryRecord record;
+  record.taskId = jo->uniqueId.toString();
+  record.requestId = requestId;
+  record.description = jo->description;
+  record.transferMode = transferMode;
+  record.start = QDateTime::currentDateTime();
+
+  QObject::connect(
+      process,
+      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+          &QProcess::finished),
+      this, [=](int exitCode, QProcess::ExitStatus exitStatus) {
+        JobHistoryRecord finished = record;
+        finished.finish = QDateTime::currentDateTime();
+        if (mQuitting) {
+          finished.status = "stopped";
+        } else if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+          finished.status = "finished";
+        } else {
+          finished.status = "error";
+        }
+        JobHistory::getInstance()->add(finished);
+        taskFinished(requestId, finished.status);
+        process->deleteLater();
+      });
+
+  QObject::connect(process, &QProcess::errorOccurred, this,
+                   [=](QProcess::ProcessError error) {
+                     if (error == QProcess::FailedToStart) {
+                       taskFinished(requestId, "error");
+                       process->deleteLater();
+                     }
+                   });
+
+  UseRclonePassword(process);
+  process->start(GetRclone(), jo->getOptions() + GetRcloneConf(),
+                 QIODevice::ReadOnly);
+  return true;
+}
+
+void HeadlessService::taskFinished(const QString &requestId,
+                                   const QString &status) {
+
+  mRunning.remove(requestId);
+
+  for (int i = 0; i < mQueue.count(); i++) {
+    if (mQueue.at(i).requestId == requestId) {
+      // stopped by quitting - stays in the queue for next start
+      if (mQuitting) {
+        mQueue[i].running = false;
+      } else {
+        mQueue.removeAt(i);
+      }
+      mQueueFileWriter->schedule();
+      break;
+    }
+  }
+
+  HeadlessScheduler *scheduler = getScheduler(requestId);
+  if (scheduler != nullptr) {
+    scheduler->setStatus(status);
+    mSchedulerFileWriter->schedule();
+  }
+
+  if (mQuitting && mRunning.isEmpty()) {
+    QCoreApplication::quit();
+    return;
+  }
+  runQueue();
+}
+
+void HeadlessService::quit() {
+
+  mQuitting = true;
+  if (mRunning.isEmpty()) {
+    QCoreApplication::quit();
+    return;
+  }
+  for (QProcess *process : mRunning) {
+#ifdef Q_OS_WIN
+    // terminate() only posts WM_CLOSE which console rclone ignores
+    process->kill();
+#else
+    process->terminate();
+#endif
+  }
+
+  QTimer::singleShot(killTimeoutMs, this, [=]() {
+    for (QProcess *process : mRunning) {
+      process->kill();
+    }
+  });
+}
+
+QString HeadlessService::getStatus() {
+
+  auto settings = GetSettingsSnapshot();
+  ListOfJobOptions *ljo = ListOfJobOptions::getInstance();
+  QStringList lines;
+
+  lines << QString("scheduler: %1")
+               .arg(settings->value("Settings/schedulerStatus").toBool()
+                        ? "running"
+                        : "stopped");
+  for (HeadlessScheduler *scheduler : mSchedulers) {
+    lines << QString("  %1 [%2] next run: %3, last run: %4")
+                 .arg(scheduler->getName())
+                 .arg(scheduler->isActive() ? "activated" : "paused")
+                 .arg(scheduler->getNextRun().toString(timeFormat))
+                 .arg(scheduler->getLastRunStatus());
+  }
+
+  lines << QString("queue: %1").arg(mQueueStatus ? "running" : "stopped");
+  for (const QueueEntry &entry : mQueue) {
+    JobOptions *jo = ljo->getTask(entry.taskId);
+    lines << QString("  %1 [%2]")
+                 .arg(jo != nullptr ? jo->description : entry.taskId)
+                 .arg(entry.running ? "running" : "waiting");
+  }
+
+  lines << QString("running transfers: %1").arg(mRunning.count());
+  return lines.join("\n") + "\n";
+}
+
+// one command per connection, reply is plain text starting with "error: "
+// when command failed
+QString HeadlessService::command(const QString &line) {
+
+  QStringList words = line.split(" ", QString::SkipEmptyParts);
+  QString name = words.isEmpty() ? QString() : words.at(0);
+
+  if (name == "status") {
+    return getStatus();
+  }
+
+  if (name == "queue" && words.count() == 2 &&
+      (words.at(1) == "start" || words.at(1) == "stop")) {
+    mQueueStatus = words.at(1) == "start";
+    auto settings = GetSettings();
+    settings->setValue("Settings/queueStatus", mQueueStatus);
+    ReloadSettingsSnapshot();
+    runQueue();
+    return QString("queue %1\n").arg(mQueueStatus ? "started" : "stopped");
+  }
+
+  if (name == "run" && words.count() == 2) {
+    JobOptions *jo = ListOfJobOptions::getInstance()->getTask(words.at(1));
+    if (jo == nullptr || jo->operation == JobOptions::Mount) {
+      return "error: no such transfer task\n";
+    }
+    if (!startTask(jo, QUuid::createUuid().toString(), "transfer")) {
+      return "error: task is already running\n";
+    }
+    return "task started\n";
+  }
+
+  if (name == "quit") {
+    QTimer::singleShot(0, this, [=]() { quit(); });
+    return "quitting\n";
+  }
+
+  return "error: unknown command, commands: status, queue start|stop, run "
+         "<task id>, quit\n";
+}
+
+int RunHeadless() {
+
+  HeadlessService service;
+  if (!service.start()) {
+    return 1;
+  }
+  return QCoreApplication::exec();
+}
+
+int RunHeadlessControl(int argc, char *argv[]) {
+
+#ifdef Q_OS_WIN
+  attachParentConsole();
+#endif
+
+  QCoreApplication app(argc, argv);
+  app.setApplicationName("rclone-browser");
+  app.setOrganizationName("rclone-browser");
+
+  QStringList args = app.arguments();
+  QString command = args.mid(args.indexOf("--control") + 1).join(" ");
+
+  QLocalSocket socket;
+  socket.connectToServer(getServerName());
+  if (!socket.waitForConnected(3000)) {
+    fprintf(stderr, "Rclone Browser is not running headless: %s\n",
+            qPrintable(socket.errorString()));
+    return 1;
+  }
+
+  socket.write(command.toUtf8() + "\n");
+  socket.waitForBytesWritten(3000);
+
+  QByteArray reply;
+  while (socket.state() == QLocalSocket::ConnectedState &&
+         socket.waitForReadyRead(30000)) {
+    reply += socket.readAll();
+  }
+  reply += socket.readAll();
+
+  fputs(reply.constData(), stdout);
+  return reply.isEmpty() || reply.startsWith("error: ") ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "pch.h"
+#include "scheduler_service.h"
+
+class DeferredFileWriter;
+class JobOptions;
+class QCron;
+
+// rclone-browser --headless
+// runs schedulers from scheduler.conf and queue from queue.conf without GUI,
+// started instead of MainWindow (only one of them can run)
+int RunHeadless();
+
+// rclone-browser --control <command>
+// sends command to running headless instance and prints its reply, exit code
+// is 1 when command failed
+int RunHeadlessControl(int argc, char *argv[]);
+
+// scheduler.conf entry - SchedulerWidget without the widget
+class HeadlessScheduler : public QObject, public ScheduledRun {
+  Q_OBJECT
+
+public:
+  explicit HeadlessScheduler(const QStringList &args,
+                             QObject *parent = nullptr);
+  ~HeadlessScheduler();
+
+  void runSchedule(bool run) override;
+
+  // args with updated last run, as saved in scheduler.conf
+  const QStringList &getArgs() const { return mArgs; }
+  QString getTaskId() const { return value("mTaskId"); }
+  QString getRequestId() const { return value("mRequestId"); }
+  QString getName() const;
+  QString getLastRunStatus() const;
+  QDateTime getNextRun() const { return mNextRun; }
+  bool isActive() const;
+  bool isQueued() const { return value("mExecutionMode") == "1"; }
+
+  // new request id for the next run
+  QString startRequest();
+
+  // same statuses as SchedulerWidget::updateTaskStatus
+  void setStatus(const QString &status);
+
+signals:
+  void runTask();
+
+private:
+  QStringList mArgs;
+  QDateTime mNextRun;
+  std::unique_ptr<QCron> mCron;
+
+  QString value(const QString &key) const;
+  void setValue(const QString &key, const QString &value);
+  bool isDailyRunDay(int dayOfWeek) const;
+  void updateNextRun(bool fromLastRun = false);
+};
+
+class HeadlessService : public QObject {
+  Q_OBJECT
+
+public:
+  explicit HeadlessService(QObject *parent = nullptr);
+  ~HeadlessService();
+
+  // false when control socket can't be created
+  bool start();
+
+private slots:
+  // stop running transfers and quit when they are gone
+  void quit();
+  void handleSignal();
+
+private:
+  struct QueueEntry {
+    QString taskId;
+    QString requestId;
+    QString dependsOn;
+    bool running = false;
+    // scheduled run waiting for busy remote - ahead of other tasks
+    bool priority = false;
+  };
+
+  QList<HeadlessScheduler *> mSchedulers;
+  QList<QueueEntry> mQueue;
+  // running transfers by request id
+  QHash<QString, QProcess *> mRunning;
+  bool mQueueStatus = false;
+  bool mQuitting = false;
+
+  QLocalServer mServer;
+  QSocketNotifier *mSignalNotifier = nullptr;
+  DeferredFileWriter *mQueueFileWriter;
+  DeferredFileWriter *mSchedulerFileWriter;
+
+  void installSignalHandlers();
+  void loadSchedulers();
+  void loadQueue();
+  QByteArray getQueueFileContent();
+  QByteArray getSchedulerFileContent();
+
+  HeadlessScheduler *getScheduler(const QString &requestId);
+  void scheduledRun(HeadlessScheduler *scheduler);
+  void runQueue();
+  void orderQueue();
+  int getQueueRunningCount();
+  QList<qint64> getQueueRunningRemaining();
+  int getQueuePriorityRow();
+  bool isRemoteBusy(const QStringList &remotes, int cap);
+  bool startTask(JobOptions *jo, const QString &requestId,
+                 const QString &transferMode);
+  void taskFinished(const QString &requestId, const QString &status);
+
+  QString command(const QString &line);
+  QString getStatus();
+};
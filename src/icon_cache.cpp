@@ -1,59 +1,250 @@
 #include "icon_cache.h"
-#include "item_model.h"
+#include "utils.h"
 #if defined(Q_OS_MACOS)
 #include "osx_helper.h"
 #endif
 
-IconCache::IconCache(QObject *parent) : QObject(parent) {
-  mFileIcon = QFileIconProvider().icon(QFileIconProvider::File);
+namespace {
 
-#if defined(Q_OS_WIN32)
-  CoInitializeEx(NULL, COINIT_MULTITHREADED);
+#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
+// icons/<theme>-<stamp>/<mime type>-<icon size>.png
+QString cacheKey(const QString &mimeName) {
+  return QString(mimeName).replace('/', '-');
+}
+
+QString sizedKey(const QString &key, int size) {
+  return QString("%1-%2").arg(key).arg(size);
+}
 #endif
 
-  mThread.start();
-  moveToThread(&mThread);
+// modification time of theme's index.theme so icons rendered from an
+// updated or another same named theme are not used
+QString themeStamp(const QString &theme) {
+  if (theme.isEmpty()) {
+    return "0";
+  }
+  for (const QString &path : QIcon::themeSearchPaths()) {
+    QFileInfo index(QDir(path).absoluteFilePath(theme + "/index.theme"));
+    if (index.exists()) {
+      return QString::number(index.lastModified().toMSecsSinceEpoch());
+    }
+  }
+  return "0";
 }
 
-IconCache::~IconCache() {
-  mThread.quit();
-  mThread.wait();
+} // namespace
 
-#if defined(Q_OS_WIN32)
-  CoUninitialize();
+IconResolver::IconResolver(const QDir &cacheDir, const QList<int> &sizes) {
+#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
+  mCacheDir = cacheDir;
+  mSizes = sizes;
+#else
+  Q_UNUSED(cacheDir);
+  Q_UNUSED(sizes);
 #endif
 }
 
-void IconCache::getIcon(Item *item, const QPersistentModelIndex &parent) {
-  QString ext = QFileInfo(item->name).suffix();
-  QIcon icon;
-  auto it = mIcons.find(ext);
-  if (it == mIcons.end()) {
+void IconResolver::preload() {
+#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
+  // theme lookup is slow so icons of the current theme are kept rendered
+  for (const QFileInfo &file :
+       mCacheDir.entryInfoList(QStringList() << "*.png", QDir::Files)) {
+    QImage image(file.absoluteFilePath());
+    if (!image.isNull()) {
+      mMimeImages.insert(file.completeBaseName(), image);
+    }
+  }
+#endif
+}
+
+void IconResolver::store(const QString &key, const QList<QImage> &images) {
+#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
+  // images are rendered one per size
+  if (images.count() != mSizes.count()) {
+    return;
+  }
+  mCacheDir.mkpath(".");
+  for (int i = 0; i < images.count(); i++) {
+    QString name = sizedKey(key, mSizes.at(i));
+    images.at(i).save(mCacheDir.absoluteFilePath(name + ".png"), "PNG");
+    mMimeImages.insert(name, images.at(i));
+  }
+#else
+  Q_UNUSED(key);
+  Q_UNUSED(images);
+#endif
+}
+
+void IconResolver::resolve(const QStringList &extensions) {
+  QHash<QString, ResolvedIcon> icons;
+  icons.reserve(extensions.count());
+
+  for (const QString &ext : extensions) {
+    ResolvedIcon icon;
 #if defined(Q_OS_WIN32)
     SHFILEINFOW info;
     if (SHGetFileInfoW(reinterpret_cast<LPCWSTR>(("dummy." + ext).utf16()),
                        FILE_ATTRIBUTE_NORMAL, &info, sizeof(info),
                        SHGFI_ICON | SHGFI_USEFILEATTRIBUTES) &&
         info.hIcon) {
-      icon = QtWin::fromHICON(info.hIcon);
+      QImage image = QtWin::imageFromHICON(info.hIcon);
       DestroyIcon(info.hIcon);
+      if (!image.isNull()) {
+        icon.images << image;
+      }
     }
 #elif defined(Q_OS_MACOS)
-    icon = osxGetIcon(ext.toUtf8().constData());
+    QImage image = osxGetIconImage(ext);
+    if (!image.isNull()) {
+      icon.images << image;
+    }
 #else
     QMimeType mime = mMimeDatabase.mimeTypeForFile(
-        item->name, QMimeDatabase::MatchExtension);
+        "dummy." + ext, QMimeDatabase::MatchExtension);
     if (mime.isValid()) {
-      icon = QIcon::fromTheme(mime.iconName());
+      QString key = cacheKey(mime.name());
+      // cached only when rendered at all current sizes
+      for (int size : mSizes) {
+        QImage image = mMimeImages.value(sizedKey(key, size));
+        if (image.isNull()) {
+          icon.images.clear();
+          break;
+        }
+        icon.images << image;
+      }
+      if (icon.images.isEmpty()) {
+        icon.themeIconName = mime.iconName();
+        icon.cacheKey = key;
+      }
+    }
+#endif
+    icons.insert(ext, icon);
+  }
+
+  emit resolved(icons);
+}
+
+IconCache::IconCache(QObject *parent) : QObject(parent) {
+  qRegisterMetaType<QHash<QString, ResolvedIcon>>();
+  qRegisterMetaType<QList<QImage>>();
+
+  mFileIcon = QFileIconProvider().icon(QFileIconProvider::File);
+
+#if defined(Q_OS_WIN32)
+  CoInitializeEx(NULL, COINIT_MULTITHREADED);
+#endif
+
+  // tree views show small icons (rendered at device pixel ratio)
+  mSizes << qApp->style()->pixelMetric(QStyle::PM_SmallIconSize);
+
+  QString theme = QIcon::themeName();
+  QDir cacheDir(GetConfigDir().absoluteFilePath(
+      "icons/" + (theme.isEmpty() ? QString("default") : theme) + "-" +
+      themeStamp(theme)));
+
+  mResolver = new IconResolver(cacheDir, mSizes);
+  mResolver->moveToThread(&mThread);
+  QObject::connect(&mThread, &QThread::started, mResolver,
+                   &IconResolver::preload);
+
+  QObject::connect(this, &IconCache::resolve, mResolver,
+                   &IconResolver::resolve);
+  QObject::connect(this, &IconCache::store, mResolver, &IconResolver::store);
+  QObject::connect(mResolver, &IconResolver::resolved, this,
+                   [=](const QHash<QString, ResolvedIcon> &icons) {
+                     for (auto it = icons.begin(); it != icons.end(); ++it) {
+                       int id = mExtensionIds.value(it.key());
+                       mIcons[id] = makeIcon(it.value());
+                       mPending.remove(id);
+                     }
+                     emit iconsReady();
+                   });
+
+  mThread.start();
+}
+
+// pixmaps are made here on GUI thread, theme icons not cached yet are looked
+// up and rendered here too and sent back to resolver to be saved
+// fallback icon is cached as well so missing theme icon isn't searched for
+// again
+QIcon IconCache::makeIcon(const ResolvedIcon &resolved) {
+  QIcon icon;
+  for (const QImage &image : resolved.images) {
+    icon.addPixmap(QPixmap::fromImage(image));
+  }
+  if (!icon.isNull()) {
+    return icon;
+  }
+
+  if (resolved.cacheKey.isEmpty()) {
+    return mFileIcon;
+  }
+
+  auto it = mThemeIcons.find(resolved.cacheKey);
+  if (it != mThemeIcons.end()) {
+    return it.value();
+  }
+
+  QIcon themed = QIcon::fromTheme(resolved.themeIconName);
+  if (themed.isNull()) {
+    themed = mFileIcon;
+  }
+
+  // rendered only at sizes tree views use
+  QList<QImage> images;
+  for (int size : mSizes) {
+    QPixmap pixmap = themed.pixmap(size, size);
+    if (!pixmap.isNull()) {
+      icon.addPixmap(pixmap);
+      images << pixmap.toImage();
     }
+  }
+  if (icon.isNull()) {
+    icon = themed;
+  } else if (images.count() == mSizes.count()) {
+    emit store(resolved.cacheKey, images);
+  }
+
+  mThemeIcons.insert(resolved.cacheKey, icon);
+  return icon;
+}
+
+IconCache::~IconCache() {
+  mThread.quit();
+  mThread.wait();
+  delete mResolver;
+
+#if defined(Q_OS_WIN32)
+  CoUninitialize();
 #endif
-    if (icon.isNull()) {
-      icon = mFileIcon;
+}
+
+// the same as QFileInfo::suffix() without parsing whole path
+int IconCache::getExtensionId(const QString &fileName) {
+  int dot = fileName.lastIndexOf('.');
+  QString ext = dot == -1 ? QString() : fileName.mid(dot + 1);
+
+  auto it = mExtensionIds.find(ext);
+  if (it != mExtensionIds.end()) {
+    return it.value();
+  }
+  int id = mExtensions.count();
+  mExtensionIds.insert(ext, id);
+  mExtensions << ext;
+  mIcons.append(QIcon());
+  return id;
+}
+
+void IconCache::requestIcons(const QSet<int> &extensionIds) {
+  QStringList missing;
+  for (int id : extensionIds) {
+    if (mIcons.at(id).isNull() && !mPending.contains(id)) {
+      mPending.insert(id);
+      missing << mExtensions.at(id);
     }
-    mIcons.insert(ext, icon);
-  } else {
-    icon = it.value();
   }
 
-  emit iconReady(item, parent, icon);
+  if (!missing.isEmpty()) {
+    emit resolve(missing);
+  }
 }
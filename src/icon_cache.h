@@ -2,28 +2,90 @@
 
 #include "pch.h"
 
-struct Item;
+// icon of one extension as resolver thread hands it over, QPixmap (and
+// QIcon made of them) can be created only on GUI thread
+struct ResolvedIcon {
+  QList<QImage> images;
+  // theme icon not rendered yet - looked up on GUI thread and stored with key
+  QString themeIconName;
+  QString cacheKey;
+};
+Q_DECLARE_METATYPE(ResolvedIcon)
+
+// resolves file icons by extension on its own thread, lives there
+class IconResolver : public QObject {
+  Q_OBJECT
+public:
+  // rendered theme icons are kept in cacheDir, one image per size
+  IconResolver(const QDir &cacheDir, const QList<int> &sizes);
+
+  // loads cached theme icons, called when resolver thread starts
+  void preload();
+
+public slots:
+  void resolve(const QStringList &extensions);
+  // theme icon rendered on GUI thread, written to cache
+  void store(const QString &key, const QList<QImage> &images);
+
+signals:
+  void resolved(const QHash<QString, ResolvedIcon> &icons);
+
+private:
+#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
+  QMimeDatabase mMimeDatabase;
+  QDir mCacheDir;
+  QList<int> mSizes;
+  // rendered theme icons by <mime type>-<icon size>
+  QHash<QString, QImage> mMimeImages;
+#endif
+};
 
+// file icons by extension shared by all item models, used from GUI thread
 class IconCache : public QObject {
   Q_OBJECT
 public:
   IconCache(QObject *parent = nullptr);
   ~IconCache();
 
-public slots:
-  void getIcon(Item *item, const QPersistentModelIndex &parent);
+  // small id of file name's extension, the same for all models
+  int getExtensionId(const QString &fileName);
+
+  // false if icon for extension is not resolved yet
+  bool findIcon(int extensionId, QIcon &icon) const {
+    if (extensionId < 0 || extensionId >= mIcons.count() ||
+        mIcons.at(extensionId).isNull()) {
+      return false;
+    }
+    icon = mIcons.at(extensionId);
+    return true;
+  }
+
+  // resolves missing extensions in one batch, every extension is requested
+  // only once
+  void requestIcons(const QSet<int> &extensionIds);
+  bool isPending() const { return !mPending.isEmpty(); }
 
 signals:
-  void iconReady(Item *item, const QPersistentModelIndex &parent,
-                 const QIcon &icon);
+  void iconsReady();
+
+  // to resolver thread
+  void resolve(const QStringList &extensions);
+  void store(const QString &key, const QList<QImage> &images);
 
 private:
   QThread mThread;
+  IconResolver *mResolver;
   QIcon mFileIcon;
+  // pixel sizes theme icons are rendered at
+  QList<int> mSizes;
+  // theme icons looked up in this run by cache key
+  QHash<QString, QIcon> mThemeIcons;
 
-  QHash<QString, QIcon> mIcons;
+  // interned extensions, icons are indexed by their ids
+  QHash<QString, int> mExtensionIds;
+  QStringList mExtensions;
+  QVector<QIcon> mIcons;
+  QSet<int> mPending;
 
-#if !defined(Q_OS_WIN32) && !defined(Q_OS_MACOS)
-  QMimeDatabase mMimeDatabase;
-#endif
+  QIcon makeIcon(const ResolvedIcon &resolved);
 };
@@ -1,6 +1,7 @@
 #include "item_model.h"
 #include "global.h"
 #include "icon_cache.h"
+#include "local_listing.h"
 #include "utils.h"
 #include <algorithm>
 
@@ -26,6 +27,42 @@ QString getNiceSize(quint64 size) {
   }
   return "0";
 }
+
+// inotify watches are limited per user so only this many expanded folders
+// are watched by all tabs together
+const int watchBudget = 1024;
+
+// options making rclone list symlinks which native listing skips, copy_links
+// follows them and links shows them as .rclonelink files
+// set in remote config (rclone config show) or environment
+bool hasLinkOptions(const QString &remote, const QString &config) {
+  QStringList options = QStringList() << "copy_links"
+                                      << "links";
+
+  for (const QString &line : config.split('\n')) {
+    int equal = line.indexOf('=');
+    if (equal > 0 && options.contains(line.left(equal).trimmed()) &&
+        line.mid(equal + 1).trimmed() != "false") {
+      return true;
+    }
+  }
+
+  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+  for (const QString &option : options) {
+    QStringList names = QStringList()
+                        << "RCLONE_" + option.toUpper()
+                        << "RCLONE_LOCAL_" + option.toUpper()
+                        << "RCLONE_CONFIG_" + remote.toUpper() + "_" +
+                               option.toUpper();
+    for (const QString &name : names) {
+      QString value = env.value(name);
+      if (!value.isEmpty() && value != "false") {
+        return true;
+      }
+    }
+  }
+  return false;
+}
 } // namespace
 
 class ItemSorter {
@@ -80,7 +117,7 @@ private:
 };
 
 ItemModel::ItemModel(IconCache *icons, const QString &remote, QObject *parent)
-    : QAbstractItemModel(parent), mRemote(remote),
+    : QAbstractItemModel(parent), mRemote(remote), mIcons(icons),
       mFixedFont(QFontDatabase::systemFont(QFontDatabase::FixedFont)),
       mRegExpFolder(
           R"(^\s*[\d-]+ (\d\d\d\d-\d\d-\d\d \d\d:\d\d:\d\d) \s*[\d-]+ (.+)$)"),
@@ -99,29 +136,26 @@ ItemModel::ItemModel(IconCache *icons, const QString &remote, QObject *parent)
   mRoot->isFolder = true;
   mRoot->state = Item::Ready;
 
-  QObject::connect(this, &ItemModel::getIcon, icons, &IconCache::getIcon);
-  QObject::connect(
-      icons, &IconCache::iconReady, this,
-      [=](Item *item, const QPersistentModelIndex &parent, const QIcon &icon) {
-        item->state = Item::Ready;
-        QString ext = QFileInfo(item->name).suffix();
-        if (!mLoadedIcons.contains(ext)) {
-          mLoadedIcons.insert(ext, icon);
-        }
-
-        if (item->isDeleted) {
-          delete item;
-          return;
-        }
-
-        QModelIndex idx = index(item->num(), 0, parent);
-        emit dataChanged(idx, idx, QVector<int>{Qt::DecorationRole});
-      });
+  // one repaint per waiting folder instead of one per file
+  QObject::connect(icons, &IconCache::iconsReady, this, [=]() {
+    for (const QPersistentModelIndex &folder : mIconFolders) {
+      int rows = folder.isValid() ? get(folder)->childs.count() : 0;
+      if (rows > 0) {
+        emit dataChanged(index(0, 0, folder), index(rows - 1, 0, folder),
+                         QVector<int>{Qt::DecorationRole});
+      }
+    }
+    if (!mIcons->isPending()) {
+      mIconFolders.clear();
+    }
+  });
 }
 
 ItemModel::~ItemModel() {
   delete mRoot;
 
+  global.watchedFolders = qMax(0, global.watchedFolders - mWatched.count());
+
   // when remote widget terminated free global rclone ls processes
   global.rcloneLsProcessCount =
       global.rcloneLsProcessCount - mLocalRcloneLsProcessCount;
@@ -157,7 +191,125 @@ void ItemModel::rename(const QModelIndex &index, const QString &name) {
   Item *item = get(index);
   item->name = name;
   item->path.setPath(item->parent->path.filePath(item->name));
-  emit dataChanged(index, index, QVector<int>{Qt::DisplayRole});
+  if (!item->isFolder) {
+    item->extensionId = mIcons->getExtensionId(item->name);
+    if (mFileIcons) {
+      requestIcons(index.parent(), QSet<int>() << item->extensionId);
+    }
+  }
+  emit dataChanged(index, index,
+                   QVector<int>{Qt::DisplayRole, Qt::DecorationRole});
+}
+
+void ItemModel::setLocal(bool local) {
+  mLocal = local;
+  if (!mLocal || mWatcher != nullptr) {
+    return;
+  }
+
+  // rclone lists folders till remote config is read
+  auto show = new QProcess(this);
+  QObject::connect(show,
+                   static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+                       &QProcess::finished),
+                   this, [=](int code, QProcess::ExitStatus status) {
+                     QString config = show->readAllStandardOutput();
+                     show->deleteLater();
+                     mNative = status == QProcess::NormalExit && code == 0 &&
+                               !hasLinkOptions(mRemote, config);
+                   });
+  UseRclonePassword(show);
+  show->start(GetRclone(),
+              QStringList() << "config"
+                            << "show" << mRemote << GetRcloneConf()
+                            << "--ask-password=false",
+              QIODevice::ReadOnly);
+
+  mWatcher = new QFileSystemWatcher(this);
+
+  // bursts of changes (like copy into folder) trigger one refresh
+  mChangedTimer.setSingleShot(true);
+  mChangedTimer.setInterval(500);
+  QObject::connect(&mChangedTimer, &QTimer::timeout, this,
+                   [=]() { refreshChanged(); });
+  QObject::connect(mWatcher, &QFileSystemWatcher::directoryChanged, this,
+                   [=](const QString &path) {
+                     mChangedFolders.insert(path);
+                     mChangedTimer.start();
+                   });
+}
+
+void ItemModel::watch(const QModelIndex &index, bool watch) {
+  if (mWatcher == nullptr || !index.isValid() || !get(index)->isFolder) {
+    return;
+  }
+
+  QString path = get(index)->path.path();
+  if (!watch) {
+    // collapsed folder hides its expanded subfolders too, they only get
+    // collapsed signal when collapsed themselves
+    for (const QString &watched : mWatched.keys()) {
+      QModelIndex folder = mWatched.value(watched);
+      while (folder.isValid() && folder != index) {
+        folder = folder.parent();
+      }
+      if (folder.isValid() || !mWatched.value(watched).isValid()) {
+        unwatch(watched);
+      }
+    }
+    return;
+  }
+  if (mWatched.contains(path)) {
+    return;
+  }
+
+  // folders removed from the tree still hold their watches
+  if (global.watchedFolders >= watchBudget) {
+    for (const QString &watched : mWatched.keys()) {
+      if (!mWatched.value(watched).isValid()) {
+        unwatch(watched);
+      }
+    }
+  }
+
+  if (global.watchedFolders < watchBudget && mWatcher->addPath(path)) {
+    mWatched.insert(path, index);
+    global.watchedFolders++;
+  }
+}
+
+void ItemModel::unwatch(const QString &path) {
+  if (mWatched.remove(path) > 0) {
+    mWatcher->removePath(path);
+    global.watchedFolders = qMax(0, global.watchedFolders - 1);
+  }
+}
+
+// changed folders are listed again without loading row, merge then only
+// inserts, removes and updates rows which differ
+void ItemModel::refreshChanged() {
+  QSet<QString> changed;
+  changed.swap(mChangedFolders);
+
+  for (const QString &path : changed) {
+    QPersistentModelIndex index = mWatched.value(path);
+    if (!index.isValid()) {
+      unwatch(path);
+      continue;
+    }
+
+    Item *item = get(index);
+    if (item->isLoading()) {
+      // change could be missed by listing in progress
+      mChangedFolders.insert(path);
+    } else if (item->state == Item::Ready) {
+      load(index, item, false);
+    }
+  }
+
+  if (!mChangedFolders.isEmpty()) {
+    mChangedTimer.start();
+  }
 }
 
 bool ItemModel::isTopLevel(const QModelIndex &index) const {
@@ -258,13 +410,12 @@ QVariant ItemModel::data(const QModelIndex &index, int role) const {
     }
 
     if (mFileIcons) {
-      QString ext = QFileInfo(item->name).suffix();
-      auto it = mLoadedIcons.find(ext);
-      if (it == mLoadedIcons.end()) {
+      QIcon icon;
+      if (!mIcons->findIcon(item->extensionId, icon)) {
         return mFileIcon;
       }
 
-      return it.value();
+      return icon;
     }
 
     return QIcon();
@@ -325,7 +476,7 @@ bool ItemModel::removeRows(int row, int count, const QModelIndex &parent) {
 
   for (int i = row; i < row + count; i++) {
     Item *node = item->childs.at(i);
-    if (node->isLoading() || node->state == Item::LoadingIcon) {
+    if (node->isLoading()) {
       node->isDeleted = true;
     } else {
       delete node;
@@ -385,14 +536,20 @@ bool ItemModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
   return false;
 }
 
+void ItemModel::requestIcons(const QPersistentModelIndex &folder,
+                             const QSet<int> &extensionIds) {
+  mIcons->requestIcons(extensionIds);
+  if (mIcons->isPending() && !mIconFolders.contains(folder)) {
+    mIconFolders << folder;
+  }
+}
+
 Item *ItemModel::get(const QModelIndex &index) const {
   return index.isValid() ? static_cast<Item *>(index.internalPointer()) : mRoot;
 }
 
-void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
-  auto lsd = new QProcess(this);
-  auto lsl = new QProcess(this);
-
+void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent,
+                     bool showLoading) {
   auto cache = new QVector<Item *>();
 
   Item *loading = new Item();
@@ -408,17 +565,24 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
     emit dataChanged(loadingIndex, loadingIndex, QVector<int>{Qt::DisplayRole});
   });
 
+  // local folders are listed in-process unless default rclone options (like
+  // filters) or remote's symlink options have to be applied
+  bool native = mLocal && mNative &&
+                GetDefaultOptionsList("defaultRcloneOptions").isEmpty();
+
   auto rcloneFinished = [=]() {
-    sender()->deleteLater();
-    // free rclone ls count (global and local)
-    mRcloneLsProcessCountMutex.lock();
-    if (global.rcloneLsProcessCount > 0) {
-      global.rcloneLsProcessCount--;
-    }
-    if (mLocalRcloneLsProcessCount > 0) {
-      mLocalRcloneLsProcessCount--;
+    if (!native) {
+      sender()->deleteLater();
+      // free rclone ls count (global and local)
+      mRcloneLsProcessCountMutex.lock();
+      if (global.rcloneLsProcessCount > 0) {
+        global.rcloneLsProcessCount--;
+      }
+      if (mLocalRcloneLsProcessCount > 0) {
+        mLocalRcloneLsProcessCount--;
+      }
+      mRcloneLsProcessCountMutex.unlock();
     }
-    mRcloneLsProcessCountMutex.unlock();
 
     parent->state =
         parent->state == Item::Loading1 ? Item::Loading2 : Item::Ready;
@@ -433,6 +597,9 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
       qDeleteAll(*cache);
       delete cache;
       delete parent;
+      if (!showLoading) {
+        delete loading;
+      }
       return;
     }
 
@@ -444,17 +611,17 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
     }
 
     QVector<Item *> todo;
+    QSet<int> extensions;
 
     bool modified = false;
     for (auto &item : *cache) {
       auto it = existing.find(item->name);
       if (it == existing.end()) {
         item->path.setPath(parent->path.filePath(item->name));
-        if (!item->isFolder && mFileIcons) {
-          QString ext = QFileInfo(item->name).suffix();
-          if (!mLoadedIcons.contains(ext)) {
-            item->state = Item::LoadingIcon;
-            emit getIcon(item, parentIndex);
+        if (!item->isFolder) {
+          item->extensionId = mIcons->getExtensionId(item->name);
+          if (mFileIcons) {
+            extensions.insert(item->extensionId);
           }
         }
         todo.append(item);
@@ -465,6 +632,9 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
             old->modified != item->modified || old->size != item->size) {
           old->state = Item::Unknown;
           old->isFolder = item->isFolder;
+          old->extensionId = item->isFolder
+                                 ? -1
+                                 : mIcons->getExtensionId(old->name);
           old->modified = item->modified;
           old->size = item->size;
           modified = true;
@@ -483,7 +653,14 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
       if (parent->childs[i] == loading ||
           existing.contains(parent->childs[i]->name)) {
         emit beginRemoveRows(parentIndex, i, i);
-        delete parent->childs.takeAt(i);
+        // folder still being listed is freed when its listing finishes
+        // (the same as in removeRows)
+        Item *node = parent->childs.takeAt(i);
+        if (node->isLoading()) {
+          node->isDeleted = true;
+        } else {
+          delete node;
+        }
         emit endRemoveRows();
         i--;
       }
@@ -500,8 +677,53 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
     if (modified) {
       sort(parentIndex, parent);
     }
+
+    // extensions of the whole folder in one request
+    requestIcons(parentIndex, extensions);
+
+    // not in childs when loading row wasn't shown
+    if (!showLoading) {
+      delete loading;
+    }
+  };
+
+  // loading row with spinner
+  auto startLoading = [=]() {
+    if (showLoading) {
+      emit beginInsertRows(parentIndex, 0, 0);
+      parent->childs.prepend(loading);
+      emit endInsertRows();
+
+      timer->start(100);
+    }
   };
 
+  if (native) {
+    auto listing = new LocalListing(
+        parent->path.path(),
+        GetSettingsSnapshot()->value("Settings/showHidden", true).toBool());
+    QObject::connect(listing, &LocalListing::finished, this, [=]() {
+      *cache = listing->takeItems();
+      for (Item *child : *cache) {
+        child->parent = parent;
+      }
+      rcloneFinished();
+    });
+    // also when model is gone before listing finishes
+    QObject::connect(listing, &LocalListing::finished, listing,
+                     &QObject::deleteLater);
+
+    // one listing instead of lsd and lsl
+    parent->state = Item::Loading2;
+    startLoading();
+
+    QThreadPool::globalInstance()->start(listing);
+    return;
+  }
+
+  auto lsd = new QProcess(this);
+  auto lsl = new QProcess(this);
+
   QObject::connect(lsd,
                    static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
                        &QProcess::finished),
@@ -552,12 +774,8 @@ void ItemModel::load(const QPersistentModelIndex &parentIndex, Item *parent) {
   });
 
   parent->state = Item::Loading1;
+  startLoading();
 
-  emit beginInsertRows(parentIndex, 0, 0);
-  parent->childs.prepend(loading);
-  emit endInsertRows();
-
-  timer->start(100);
   UseRclonePassword(lsd);
   UseRclonePassword(lsl);
 
@@ -7,7 +7,7 @@ struct Item {
 
   ~Item() {
     for (auto child : childs) {
-      if (child->isLoading() || state == LoadingIcon) {
+      if (child->isLoading()) {
         child->isDeleted = true;
       } else {
         delete child;
@@ -24,12 +24,14 @@ struct Item {
 
   Item *parent = nullptr;
 
-  enum State { Unknown, Loading1, Loading2, Ready, Special, LoadingIcon };
+  enum State { Unknown, Loading1, Loading2, Ready, Special };
 
   State state = Unknown;
   bool isFolder = false;
   bool isDeleted = false;
   QString name;
+  // IconCache::getExtensionId of file name, -1 for folders
+  int extensionId = -1;
   QDir path;
   QString modified;
   quint64 size = 0;
@@ -52,6 +54,10 @@ public:
   void rename(const QModelIndex &index, const QString &name);
   bool isTopLevel(const QModelIndex &index) const;
   bool isFolder(const QModelIndex &index) const;
+  // folders of local remote are listed without rclone and can be watched
+  void setLocal(bool local);
+  // watched local folder is refreshed when it changes on disk
+  void watch(const QModelIndex &index, bool watch);
 
   QModelIndex addRoot(const QString &name, const QString &path);
 
@@ -76,15 +82,25 @@ public:
                     int column, const QModelIndex &parent) override;
 
 signals:
-  void getIcon(Item *item, const QPersistentModelIndex &index);
   void drop(const QDir &path, const QModelIndex &parent);
 
 private:
   Item *mRoot;
 
   QString mRemote;
+  bool mLocal = false;
+  // local folders listed in-process, set once remote config is checked
+  bool mNative = false;
 
-  QHash<QString, QIcon> mLoadedIcons;
+  QFileSystemWatcher *mWatcher = nullptr;
+  // watched folders by path
+  QHash<QString, QPersistentModelIndex> mWatched;
+  QSet<QString> mChangedFolders;
+  QTimer mChangedTimer;
+
+  IconCache *mIcons;
+  // folders with files waiting for their icons
+  QList<QPersistentModelIndex> mIconFolders;
 
   bool mFolderIcons;
   bool mFileIcons;
@@ -104,7 +120,13 @@ private:
   QMutex mRcloneLsProcessCountMutex;
 
   Item *get(const QModelIndex &index) const;
-  void load(const QPersistentModelIndex &parentIndex, Item *parent);
+  void load(const QPersistentModelIndex &parentIndex, Item *parent,
+            bool showLoading = true);
+  void unwatch(const QString &path);
+  void refreshChanged();
+  // folder is repainted when icons are resolved
+  void requestIcons(const QPersistentModelIndex &folder,
+                    const QSet<int> &extensionIds);
 
   void sortRecursive(Item *item, const ItemSorter &sorter);
   void sort(const QModelIndex &parent, Item *item);
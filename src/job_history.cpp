@@ -0,0 +1,161 @@
+#include "job_history.h"
+#include "utils.h"
+
+JobHistory *JobHistory::History = nullptr;
+const QString JobHistory::persistenceFileName = "history.log";
+
+qint64 JobHistoryRecord::durationSecs() const {
+  if (!start.isValid() || !finish.isValid()) {
+    return 0;
+  }
+  return start.secsTo(finish);
+}
+
+qint64 JobHistoryRecord::averageRate() const {
+  qint64 secs = durationSecs();
+  if (secs <= 0) {
+    return bytes;
+  }
+  return bytes / secs;
+}
+
+JobHistory::JobHistory() {}
+
+JobHistory *JobHistory::getInstance() {
+  if (History == nullptr) {
+    History = new JobHistory();
+  }
+  return History;
+}
+
+// every run is appended as one json line so existing entries are never
+// rewritten
+bool JobHistory::add(const JobHistoryRecord &record) {
+
+  QJsonObject entry;
+  entry.insert("taskId", record.taskId);
+  entry.insert("requestId", record.requestId);
+  entry.insert("description", record.description);
+  entry.insert("mode", record.transferMode);
+  entry.insert("status", record.status);
+  entry.insert("start", record.start.toString(Qt::ISODate));
+  entry.insert("finish", record.finish.toString(Qt::ISODate));
+  // qint64 stored as string to not loose precision in json double
+  entry.insert("bytes", QString::number(record.bytes));
+  entry.insert("files", QString::number(record.files));
+  entry.insert("errors", QString::number(record.errors));
+
+  QDir outputDir = GetConfigDir();
+  if (!outputDir.exists()) {
+    outputDir.mkpath(".");
+  }
+
+  QFile file(outputDir.absoluteFilePath(persistenceFileName));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    return false;
+  }
+
+  file.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + "\n");
+  file.close();
+
+  if (mLoaded) {
+    records.append(record);
+  }
+  mEstimatesValid = false;
+
+  emit historyUpdated();
+  return true;
+}
+
+void JobHistory::load() {
+
+  mLoaded = true;
+
+  QFile file(GetConfigDir().absoluteFilePath(persistenceFileName));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  while (!file.atEnd()) {
+    QByteArray line = file.readLine().trimmed();
+    if (line.isEmpty()) {
+      continue;
+    }
+
+    QJsonParseError jsonError;
+    QJsonDocument document = QJsonDocument::fromJson(line, &jsonError);
+    // skip damaged lines (e.g. partially written when app crashed)
+    if (jsonError.error != QJsonParseError::NoError || !document.isObject()) {
+      continue;
+    }
+
+    QJsonObject entry = document.object();
+    JobHistoryRecord record;
+    record.taskId = entry.value("taskId").toString();
+    record.requestId = entry.value("requestId").toString();
+    record.description = entry.value("description").toString();
+    record.transferMode = entry.value("mode").toString();
+    record.status = entry.value("status").toString();
+    record.start =
+        QDateTime::fromString(entry.value("start").toString(), Qt::ISODate);
+    record.finish =
+        QDateTime::fromString(entry.value("finish").toString(), Qt::ISODate);
+    record.bytes = entry.value("bytes").toString().toLongLong();
+    record.files = entry.value("files").toString().toLongLong();
+    record.errors = entry.value("errors").toString().toLongLong();
+    records.append(record);
+  }
+
+  file.close();
+}
+
+const QList<JobHistoryRecord> &JobHistory::getRecords() {
+  if (!mLoaded) {
+    load();
+  }
+  return records;
+}
+
+QList<JobHistoryRecord> JobHistory::getTaskRecords(const QString &taskId) {
+
+  QList<JobHistoryRecord> taskRecords;
+
+  for (const JobHistoryRecord &record : getRecords()) {
+    if (record.taskId == taskId) {
+      taskRecords.append(record);
+    }
+  }
+  return taskRecords;
+}
+
+QHash<QString, qint64> JobHistory::getEstimatedDurations() {
+
+  if (mEstimatesValid) {
+    return mEstimates;
+  }
+
+  QHash<QString, qint64> totalSecs;
+  QHash<QString, int> runs;
+
+  const QList<JobHistoryRecord> &allRecords = getRecords();
+
+  // newest first, only last estimateRuns runs of every task count
+  for (int i = allRecords.count() - 1; i >= 0; --i) {
+    const JobHistoryRecord &record = allRecords.at(i);
+
+    if (record.status != "finished" || record.transferMode == "dryrun" ||
+        runs.value(record.taskId) >= estimateRuns) {
+      continue;
+    }
+
+    totalSecs[record.taskId] += record.durationSecs();
+    runs[record.taskId]++;
+  }
+
+  mEstimates.clear();
+  for (auto it = runs.constBegin(); it != runs.constEnd(); ++it) {
+    mEstimates.insert(it.key(), totalSecs.value(it.key()) / it.value());
+  }
+  mEstimatesValid = true;
+  return mEstimates;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pch.h"
+
+// single finished run of a transfer
+struct JobHistoryRecord {
+  QString taskId;
+  QString requestId;
+  QString description;
+  QString transferMode;
+  QString status;
+  QDateTime start;
+  QDateTime finish;
+  qint64 bytes = 0;
+  qint64 files = 0;
+  qint64 errors = 0;
+
+  qint64 durationSecs() const;
+  // bytes per second
+  qint64 averageRate() const;
+};
+
+// append-only log of transfer runs kept in history.log in config folder
+class JobHistory : public QObject {
+  Q_OBJECT
+
+protected:
+  ~JobHistory() = default;
+  JobHistory();
+
+public:
+  static JobHistory *getInstance();
+  bool add(const JobHistoryRecord &record);
+  const QList<JobHistoryRecord> &getRecords();
+  QList<JobHistoryRecord> getTaskRecords(const QString &taskId);
+  // expected duration in seconds per task id based on its recent successful
+  // runs, tasks without such runs are not included
+  // computed once and kept until next run is added
+  QHash<QString, qint64> getEstimatedDurations();
+
+signals:
+  void historyUpdated();
+
+private:
+  static JobHistory *History;
+  static const QString persistenceFileName;
+  static const int estimateRuns = 5;
+
+  QList<JobHistoryRecord> records;
+  bool mLoaded = false;
+  void load();
+
+  QHash<QString, qint64> mEstimates;
+  bool mEstimatesValid = false;
+};
@@ -0,0 +1,160 @@
+#include "job_history_dialog.h"
+#include "list_of_job_options.h"
+#include "utils.h"
+
+static QString formatDuration(qint64 secs) {
+  return QString("%1:%2:%3")
+      .arg(secs / 3600, 2, 10, QChar('0'))
+      .arg((secs % 3600) / 60, 2, 10, QChar('0'))
+      .arg(secs % 60, 2, 10, QChar('0'));
+}
+
+JobHistoryDialog::JobHistoryDialog(const QString &taskId, QWidget *parent)
+    : QDialog(parent) {
+
+  ui.setupUi(this);
+
+  auto settings = GetSettings();
+
+  // set minimumWidth based on font size
+  int fontsize = 0;
+  fontsize = (settings->value("Settings/fontSize").toInt());
+  setMinimumWidth(minimumWidth() + (fontsize * 30));
+
+  ui.table->setColumnCount(8);
+  ui.table->setHorizontalHeaderLabels(QStringList()
+                                      << "Task"
+                                      << "Started"
+                                      << "Duration"
+                                      << "Status"
+                                      << "Transferred"
+                                      << "Files"
+                                      << "Errors"
+                                      << "Avg speed");
+
+  // only saved tasks with at least one recorded run can be selected
+  QSet<QString> recordedTasks;
+  for (const JobHistoryRecord &record :
+       JobHistory::getInstance()->getRecords()) {
+    recordedTasks.insert(record.taskId);
+  }
+
+  ui.task->addItem("All transfers", QString());
+  for (JobOptions *jo : ListOfJobOptions::getInstance()->getTasks()) {
+    if (jo->operation != JobOptions::Mount &&
+        recordedTasks.contains(jo->uniqueId.toString())) {
+      ui.task->addItem(jo->description, jo->uniqueId.toString());
+    }
+  }
+
+  int taskIndex = ui.task->findData(taskId);
+  ui.task->setCurrentIndex(taskIndex < 0 ? 0 : taskIndex);
+
+  QObject::connect(ui.task,
+                   static_cast<void (QComboBox::*)(int)>(
+                       &QComboBox::currentIndexChanged),
+                   this, [=]() { refresh(); });
+
+  QObject::connect(JobHistory::getInstance(), &JobHistory::historyUpdated,
+                   this, [=]() { refresh(); });
+
+  QObject::connect(ui.buttonBox, &QDialogButtonBox::rejected, this,
+                   &QDialog::reject);
+
+  refresh();
+}
+
+JobHistoryDialog::~JobHistoryDialog() {}
+
+void JobHistoryDialog::refresh() {
+
+  QString taskId = ui.task->currentData().toString();
+
+  QList<JobHistoryRecord> records;
+  if (taskId.isEmpty()) {
+    records = JobHistory::getInstance()->getRecords();
+  } else {
+    records = JobHistory::getInstance()->getTaskRecords(taskId);
+  }
+
+  ui.table->setRowCount(records.count());
+
+  // newest first
+  int row = 0;
+  for (int i = records.count() - 1; i >= 0; --i, ++row) {
+    const JobHistoryRecord &record = records.at(i);
+
+    QStringList columns;
+    columns << record.description
+            << QLocale(QLocale::English)
+                   .toString(record.start, "ddd, dd/MMM/yyyy HH:mm:ss")
+            << formatDuration(record.durationSecs()) << record.status
+            << FormatSize(record.bytes) << QString::number(record.files)
+            << QString::number(record.errors)
+            << FormatSize(record.averageRate()) + "/s";
+
+    for (int column = 0; column < columns.count(); ++column) {
+      auto item = new QTableWidgetItem(columns.at(column));
+      if (column >= 4) {
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+      }
+      if (record.status != "finished") {
+        item->setForeground(Qt::red);
+      }
+      ui.table->setItem(row, column, item);
+    }
+    ui.table->item(row, 0)->setToolTip(record.description);
+  }
+
+  ui.table->resizeColumnsToContents();
+  updateSummary(records);
+}
+
+// averages of successful runs and comparison of the latest run against them,
+// so tasks getting slower over time stand out
+void JobHistoryDialog::updateSummary(const QList<JobHistoryRecord> &records) {
+
+  QList<JobHistoryRecord> finished;
+  for (const JobHistoryRecord &record : records) {
+    if (record.status == "finished") {
+      finished.append(record);
+    }
+  }
+
+  if (finished.isEmpty()) {
+    ui.summary->setText(records.isEmpty() ? "No runs recorded"
+                                          : "No successful runs recorded");
+    return;
+  }
+
+  qint64 totalSecs = 0;
+  qint64 totalBytes = 0;
+  for (const JobHistoryRecord &record : finished) {
+    totalSecs += record.durationSecs();
+    totalBytes += record.bytes;
+  }
+
+  QString summary =
+      QString("Successful runs: %1, average duration: %2, average size: %3, "
+              "average speed: %4/s")
+          .arg(finished.count())
+          .arg(formatDuration(totalSecs / finished.count()))
+          .arg(FormatSize(totalBytes / finished.count()))
+          .arg(FormatSize(totalSecs > 0 ? totalBytes / totalSecs : 0));
+
+  if (!ui.task->currentData().toString().isEmpty() && finished.count() > 1) {
+    const JobHistoryRecord &last = finished.last();
+    qint64 previousSecs = totalSecs - last.durationSecs();
+    qint64 previousAverage = previousSecs / (finished.count() - 1);
+
+    if (previousAverage > 0) {
+      qint64 change =
+          (last.durationSecs() - previousAverage) * 100 / previousAverage;
+      summary += QString("\nLast run took %1% %2 than previous average")
+                     .arg(qAbs(change))
+                     .arg(change > 0 ? "longer" : "less");
+    }
+  }
+
+  ui.summary->setText(summary);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "job_history.h"
+#include "pch.h"
+#include "ui_job_history_dialog.h"
+
+class JobHistoryDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  JobHistoryDialog(const QString &taskId = QString(),
+                   QWidget *parent = nullptr);
+  ~JobHistoryDialog();
+
+private:
+  Ui::JobHistoryDialog ui;
+
+  void refresh();
+  void updateSummary(const QList<JobHistoryRecord> &records);
+};
@@ -159,15 +159,7 @@ QStringList JobOptions::getOptions() const {
   if (!extra.isEmpty()) {
 
     for (auto line : extra.split('\n')) {
-      // split on spaces but not if inside quotes e.g. --option-1
-      // --option-2="arg1 arg2" --option-3 arg3 should generate "--option-1"
-      // "--option-2=\"arg1 arg2\"" "--option-3" "arg3"
-      for (QString arg :
-           line.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-        if (!arg.isEmpty()) {
-          list << arg.replace("\"", "");
-        }
-      }
+      list << SplitCommandLine(line);
     }
   }
 
@@ -115,9 +115,19 @@ public:
   JobOptions *GetData() { return mJobData; }
   QString GetRequestId() { return mRequestId; }
 
+  // queue entry (requestId) which has to finish before this one starts
+  void SetDependsOn(const QString &requestId) { mDependsOn = requestId; }
+  QString GetDependsOn() { return mDependsOn; }
+
+  // waits ahead of other tasks in the queue
+  void SetPriority(bool priority) { mPriority = priority; }
+  bool GetPriority() { return mPriority; }
+
 private:
   JobOptions *mJobData;
   QString mRequestId;
+  QString mDependsOn;
+  bool mPriority = false;
 };
 
 class SerializationException : public QException {
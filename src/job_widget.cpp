@@ -40,7 +40,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
 
   ui.details->setVisible(false);
 
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
 
   int fontsize = 0;
   fontsize = (settings->value("Settings/fontSize").toInt());
@@ -50,7 +50,6 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
 #endif
 
   QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-  QFontMetrics fm(font);
 
   font.setPointSize(font.pointSize() + fontsize);
 
@@ -59,16 +58,8 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
 
   QString iconsColour = settings->value("Settings/iconsColour").toString();
 
-  QString img_add = "";
-
-  if (iconsColour == "white") {
-    img_add = "_inv";
-  }
-
-  ui.showDetails->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
-  ui.showOutput->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
+  ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
 
   ui.showDetails->setIconSize(QSize(24, 24));
   ui.showOutput->setIconSize(QSize(24, 24));
@@ -78,12 +69,10 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
         ui.details->setVisible(checked);
 
         if (checked) {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vdownarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         } else {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         }
       });
@@ -93,18 +82,15 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
         ui.output->setVisible(checked);
 
         if (checked) {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vdownarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         } else {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         }
       });
 
-  ui.cancel->setIcon(
-      QIcon(":media/images/qbutton_icons/cancel" + img_add + ".png"));
+  ui.cancel->setIcon(GetButtonIcon("cancel"));
   ui.cancel->setIconSize(QSize(24, 24));
 
   QObject::connect(ui.cancel, &QToolButton::clicked, this, [=]() {
@@ -122,8 +108,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
     }
   });
 
-  ui.copy->setIcon(
-      QIcon(":media/images/qbutton_icons/copy" + img_add + ".png"));
+  ui.copy->setIcon(GetButtonIcon("copy"));
   ui.copy->setIconSize(QSize(24, 24));
 
   QObject::connect(ui.copy, &QToolButton::clicked, this, [=]() {
@@ -131,6 +116,48 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
     clipboard->setText(mArgs.join(" "));
   });
 
+  int bwIndex = args.indexOf("--bwlimit");
+  if (bwIndex != -1 && bwIndex + 1 < args.count()) {
+    mBwLimit = args.at(bwIndex + 1);
+    ui.bwLimit->setText(mBwLimit);
+  }
+
+  ui.pause->setIcon(GetButtonIcon("pause"));
+  ui.pause->setIconSize(QSize(24, 24));
+
+  QObject::connect(ui.bwLimit, &QLineEdit::returnPressed, this, [=]() {
+    QString rate = ui.bwLimit->text().trimmed();
+    if (rate.isEmpty()) {
+      rate = "off";
+    }
+    mBwLimit = rate;
+    // when paused new limit is applied on resume
+    if (!ui.pause->isChecked()) {
+      rcCommand(QStringList() << "core/bwlimit"
+                              << "rate=" + mBwLimit);
+    }
+  });
+
+  QObject::connect(ui.pause, &QToolButton::toggled, this, [=](bool checked) {
+    if (checked) {
+      // rclone can't suspend running transfer - throttle it to 1 KiB/s
+      rcCommand(QStringList() << "core/bwlimit"
+                              << "rate=1k");
+      ui.pause->setIcon(GetButtonIcon("run"));
+      ui.pause->setToolTip("Resume transfer");
+      ui.pause->setStatusTip("Resume transfer");
+      ui.showDetails->setText("  Paused");
+    } else {
+      rcCommand(QStringList() << "core/bwlimit"
+                              << "rate=" + mBwLimit);
+      ui.pause->setIcon(GetButtonIcon("pause"));
+      ui.pause->setToolTip("Pause transfer");
+      ui.pause->setStatusTip("Pause transfer");
+      ui.showDetails->setText("  Running");
+    }
+    ui.pause->setIconSize(QSize(24, 24));
+  });
+
   QObject::connect(mProcess, &QProcess::readyRead, this, [=]() {
     // regex101.com great for testing regexp
     QRegExp rxSize(
@@ -185,6 +212,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
 
       if (rxSize.exactMatch(line)) {
         ui.size->setText(rxSize.cap(1));
+        mTransferredBytes = ParseRcloneSize(rxSize.cap(1));
 
         ui.progress_info->setStyleSheet(
             "QLabel { color: green; font-weight: bold;}");
@@ -195,6 +223,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
         ui.size->setText(rxSize2.cap(1) + " " + rxSize2.cap(2) + "B" + ", " +
                          rxSize2.cap(5));
         ui.bandwidth->setText(rxSize2.cap(6));
+        mTransferredBytes = ParseRcloneSize(rxSize2.cap(1) + rxSize2.cap(2));
         ui.eta->setText(rxSize2.cap(8));
         ui.totalsize->setText(rxSize2.cap(3) + " " + rxSize2.cap(4));
         ui.progress_info->setStyleSheet(
@@ -203,6 +232,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
       } else if (rxSize3.exactMatch(line)) {
         ui.size->setText(rxSize3.cap(1) + ", " + rxSize3.cap(3));
         ui.bandwidth->setText(rxSize3.cap(4));
+        mTransferredBytes = ParseRcloneSize(rxSize3.cap(1));
         ui.eta->setText(rxSize3.cap(5));
         ui.totalsize->setText(rxSize3.cap(2));
         ui.progress_info->setStyleSheet(
@@ -210,6 +240,7 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
         ui.progress_info->setText("(" + rxSize3.cap(3) + ")");
       } else if (rxErrors.exactMatch(line)) {
         ui.errors->setText(rxErrors.cap(1));
+        mErrorsCount = rxErrors.cap(1).toLongLong();
 
         if (!(rxErrors.cap(1).toInt() == 0)) {
           ui.progress_info->setStyleSheet(
@@ -224,7 +255,9 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
                            rxChecks2.cap(3));
       } else if (rxTransferred.exactMatch(line)) {
         ui.transferred->setText(rxTransferred.cap(1));
+        mTransferredFiles = rxTransferred.cap(1).toLongLong();
       } else if (rxTransferred2.exactMatch(line)) {
+        mTransferredFiles = rxTransferred2.cap(1).toLongLong();
         ui.transferred->setText(rxTransferred2.cap(1) + " / " +
                                 rxTransferred2.cap(2) + ", " +
                                 rxTransferred2.cap(3));
@@ -358,6 +391,8 @@ JobWidget::JobWidget(QProcess *process, const QString &info,
         }
 
         isRunning = false;
+        ui.bwLimit->setEnabled(false);
+        ui.pause->setEnabled(false);
         if (status == 0) {
           if (iconsColour == "white") {
             ui.showDetails->setStyleSheet(
@@ -409,6 +444,9 @@ void JobWidget::cancel() {
   mJobFinalStatus = "stopped";
   mStatus = "2_transfer_stopped";
 
+  ui.bwLimit->setEnabled(false);
+  ui.pause->setEnabled(false);
+
   mProcess->kill();
   mProcess->waitForFinished();
 
@@ -420,8 +458,55 @@ void JobWidget::cancel() {
   ui.cancel->setStatusTip("Close");
 }
 
+void JobWidget::setRcEndpoint(int port, const QString &user,
+                              const QString &password) {
+  mRcPort = port;
+  mRcUser = user;
+  mRcPass = password;
+
+  ui.bwLimit->setEnabled(mRcPort != 0);
+  ui.pause->setEnabled(mRcPort != 0);
+}
+
+int JobWidget::getRcPort() { return mRcPort; }
+
+// run "rclone rc" command against running transfer
+void JobWidget::rcCommand(const QStringList &params) {
+  if (mRcPort == 0 || !isRunning) {
+    return;
+  }
+
+  QProcess *rc = new QProcess(this);
+  rc->setProcessChannelMode(QProcess::MergedChannels);
+
+  QObject::connect(
+      rc,
+      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+          &QProcess::finished),
+      this, [=](int status, QProcess::ExitStatus) {
+        if (status != 0) {
+          ui.output->appendPlainText("rclone rc " + params.join(" ") +
+                                     " failed:");
+          ui.output->appendPlainText(QString(rc->readAll()).trimmed());
+        }
+        rc->deleteLater();
+      });
+
+  QStringList args;
+  args << "rc" << params;
+  args << "--rc-addr"
+       << "localhost:" + QString::number(mRcPort);
+  args << "--rc-user=" + mRcUser << "--rc-pass=" + mRcPass;
+
+  rc->start(GetRclone(), args, QIODevice::ReadOnly);
+}
+
 QString JobWidget::getUniqueID() { return mUniqueID; }
 
+QString JobWidget::getSource() { return ui.source->text(); }
+
+QString JobWidget::getDest() { return ui.dest->text(); }
+
 QString JobWidget::getRequestId() { return mRequestId; }
 
 QString JobWidget::getTransferMode() { return mTransferMode; }
@@ -440,3 +525,20 @@ void JobWidget::updateStartFinishInfo() {
 }
 
 QString JobWidget::getStatus() { return mStatus; }
+
+JobHistoryRecord JobWidget::getHistoryRecord() {
+
+  JobHistoryRecord record;
+  record.taskId = mUniqueID;
+  record.requestId = mRequestId;
+  record.description = ui.info->text();
+  // dry runs don't tell how long real transfer takes
+  record.transferMode = mArgs.contains("--dry-run") ? "dryrun" : mTransferMode;
+  record.status = mJobFinalStatus;
+  record.start = mStartDateTime;
+  record.finish = mFinishDateTime;
+  record.bytes = mTransferredBytes;
+  record.files = mTransferredFiles;
+  record.errors = mErrorsCount;
+  return record;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "job_history.h"
 #include "pch.h"
 #include "ui_job_widget.h"
 
@@ -17,12 +18,19 @@ public:
   bool isRunning = true;
   QDateTime getStartDateTime();
   QString getStatus();
+  JobHistoryRecord getHistoryRecord();
+
+  // enable live controls through transfer's rclone remote control
+  void setRcEndpoint(int port, const QString &user, const QString &password);
+  int getRcPort();
 
 public slots:
   void cancel();
   QString getUniqueID();
   QString getRequestId();
   QString getTransferMode();
+  QString getSource();
+  QString getDest();
 
 signals:
   void finished(const QString &info, const QString &jobFinalStatus);
@@ -46,6 +54,19 @@ private:
   // 0 - running, 1 - finished, 2 - error
   QString mStatus = "0_transfer_running";
 
+  // rclone remote control endpoint, 0 - not available
+  int mRcPort = 0;
+  QString mRcUser = "";
+  QString mRcPass = "";
+  // bandwidth limit restored when transfer is resumed
+  QString mBwLimit = "off";
+  void rcCommand(const QStringList &params);
+
+  // totals parsed from rclone stats, used for history
+  qint64 mTransferredBytes = 0;
+  qint64 mTransferredFiles = 0;
+  qint64 mErrorsCount = 0;
+
   QDateTime mStartDateTime = QDateTime::currentDateTime();
   QDateTime mFinishDateTime;
   void updateStartFinishInfo();
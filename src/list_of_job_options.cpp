@@ -15,78 +15,110 @@ static QDataStream &operator>>(QDataStream &in, JobOptions::MountCacheLevel &e);
 
 ListOfJobOptions *ListOfJobOptions::SavedJobOptions = nullptr;
 const QString ListOfJobOptions::persistenceFileName = "tasks.bin";
+const QString ListOfJobOptions::storeFileName = "tasks.db";
+
+// tasks.db layout:
+// header: magic, version
+// records: magic, body length, body CRC-16, body
+// body: record type, task uniqueId, serialized JobOptions (put only)
+// the last record of given uniqueId wins
+static const quint32 storeMagic = 0x52425453;
+static const quint32 storeVersion = 1;
+static const quint32 recordMagic = 0x52424a4f;
+static const int recordHeaderSize = 10;
+enum StoreRecordType : quint8 { PutRecord = 1, RemoveRecord = 2 };
+
+static QByteArray makeStoreRecord(quint8 recordType, JobOptions *jo) {
+  QByteArray body;
+  QDataStream bodyStream(&body, QIODevice::WriteOnly);
+  bodyStream.setVersion(QDataStream::Qt_5_2);
+  bodyStream << recordType << jo->uniqueId;
+  if (recordType == PutRecord) {
+    bodyStream << *jo;
+  }
+
+  QByteArray record;
+  QDataStream recordStream(&record, QIODevice::WriteOnly);
+  recordStream.setVersion(QDataStream::Qt_5_2);
+  recordStream << recordMagic << quint32(body.size())
+               << qChecksum(body.constData(), body.size());
+  record.append(body);
+  return record;
+}
+
+static QByteArray makeStoreHeader() {
+  QByteArray header;
+  QDataStream headerStream(&header, QIODevice::WriteOnly);
+  headerStream.setVersion(QDataStream::Qt_5_2);
+  headerStream << storeMagic << storeVersion;
+  return header;
+}
 
 ListOfJobOptions::ListOfJobOptions() {}
 
 ListOfJobOptions *ListOfJobOptions::getInstance() {
   if (SavedJobOptions == nullptr) {
     SavedJobOptions = new ListOfJobOptions();
-    RestoreFromUserData(*SavedJobOptions);
+    if (!SavedJobOptions->RestoreFromStore()) {
+      // no task store yet - migrate tasks saved by older versions
+      RestoreFromUserData(*SavedJobOptions);
+      if (!SavedJobOptions->tasks.isEmpty()) {
+        SavedJobOptions->CompactStore();
+      }
+    }
+    SavedJobOptions->rebuildIndex();
   }
   return SavedJobOptions;
 }
 
 bool ListOfJobOptions::Persist(JobOptions *jo) {
-  bool isNew = !this->tasks.contains(jo);
-  if (isNew)
+  bool isNew = (index.value(jo->uniqueId) != jo);
+  if (isNew) {
     this->tasks.append(jo);
-  else {
-    //    int ix = tasks.indexOf(jo);
-    //    JobOptions *old = tasks[ix];
-    //    qDebug() << QString("old [%1] New [%2]")
-    //                    .arg(old->description)
-    //                    .arg(jo->description);
+    index.insert(jo->uniqueId, jo);
   }
-  PersistToUserData();
+  AppendToStore(PutRecord, jo);
+  emit tasksListUpdated();
   return isNew;
 }
 
 bool ListOfJobOptions::Forget(JobOptions *jo) {
-  bool isKnown = this->tasks.contains(jo);
+  bool isKnown = (index.value(jo->uniqueId) == jo);
   if (!isKnown)
     return false;
-  int ix = tasks.indexOf(jo);
-  tasks.removeAt(ix);
+  tasks.removeOne(jo);
+  index.remove(jo->uniqueId);
   //  qDebug() << QString("removed [%1]").arg(jo->description);
-  PersistToUserData();
+  AppendToStore(RemoveRecord, jo);
+  emit tasksListUpdated();
   return isKnown;
 }
 
-QFile *ListOfJobOptions::GetPersistenceFile(QIODevice::OpenModeFlag mode) {
+JobOptions *ListOfJobOptions::getTask(const QString &uniqueId) const {
+  return index.value(QUuid(uniqueId), nullptr);
+}
 
-  QDir outputDir;
-
-  if (IsPortableMode()) {
-    // in portable mode tasks' file will be saved in the same folder as
-    // excecutable
-#ifdef Q_OS_MACOS
-    // on macOS excecutable file is located in
-    // ./rclone-browser.app/Contents/MasOS/
-    // to get actual bundle folder we have
-    // to traverse three levels up
-    outputDir = QDir(qApp->applicationDirPath() + "/../../..");
-#else
-#ifdef Q_OS_WIN
-    // not macOS
-    outputDir = QDir(qApp->applicationDirPath());
-#else
-    QString xdg_config_home = qgetenv("XDG_CONFIG_HOME");
-    outputDir = QDir(xdg_config_home + "/rclone-browser");
-#endif
-#endif
-
-  } else {
-
-    // get data location folder from Qt  - OS dependend
-    outputDir =
-        QDir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+void ListOfJobOptions::rebuildIndex() {
+  index.clear();
+  index.reserve(tasks.count());
+  for (JobOptions *jo : tasks) {
+    index.insert(jo->uniqueId, jo);
   }
+}
+
+QString ListOfJobOptions::GetPersistenceFilePath(const QString &fileName) {
+
+  QDir outputDir = GetConfigDir();
 
   if (!outputDir.exists()) {
     outputDir.mkpath(".");
   }
-  QString filePath = outputDir.absoluteFilePath(persistenceFileName);
-  QFile *file = new QFile(filePath);
+  return outputDir.absoluteFilePath(fileName);
+}
+
+QFile *ListOfJobOptions::GetPersistenceFile(QIODevice::OpenModeFlag mode) {
+
+  QFile *file = new QFile(GetPersistenceFilePath(persistenceFileName));
 
   if (!file->open(mode)) {
     //    qDebug() << QString("Could not open ") << file->fileName();
@@ -122,35 +154,141 @@ bool ListOfJobOptions::RestoreFromUserData(ListOfJobOptions &dataIn) {
   return true;
 }
 
-bool ListOfJobOptions::PersistToUserData() {
-  QFile *file = GetPersistenceFile(QIODevice::ReadOnly);
+// read task store, damaged records are skipped and torn record at the end
+// (e.g. after crash during write) is dropped by compaction
+bool ListOfJobOptions::RestoreFromStore() {
+  QFile file(GetPersistenceFilePath(storeFileName));
 
-  if (file == nullptr)
+  if (!file.open(QIODevice::ReadOnly) || file.size() < 8) {
     return false;
+  }
 
-  QFileInfo fileToSaveInfo(*file);
-
-  QSaveFile fileToSave(fileToSaveInfo.absoluteFilePath());
+  qint64 size = file.size();
+  uchar *data = file.map(0, size);
+  if (data == nullptr) {
+    return false;
+  }
 
-  // note this mode implies Truncate also
-  if (!fileToSave.open(QIODevice::WriteOnly)) {
-    file->close();
-    delete file;
+  // no copy - stream reads directly from mapped file
+  QByteArray content =
+      QByteArray::fromRawData(reinterpret_cast<const char *>(data), size);
+  QDataStream in(content);
+  in.setVersion(QDataStream::Qt_5_2);
+
+  quint32 magic;
+  quint32 version;
+  in >> magic >> version;
+  if (magic != storeMagic || version > storeVersion) {
+    file.unmap(data);
     return false;
   }
 
-  QDataStream outstream(&fileToSave);
+  QHash<QUuid, int> positions;
+  qint64 pos = 8;
+  bool damaged = false;
 
-  outstream.setVersion(QDataStream::Qt_5_2);
-  for (JobOptions *it : tasks) {
-    outstream << *it;
+  while (pos + recordHeaderSize <= size) {
+    quint32 length;
+    quint16 checksum;
+    in.device()->seek(pos);
+    in >> magic >> length >> checksum;
+
+    if (magic != recordMagic || pos + recordHeaderSize + length > size) {
+      break;
+    }
+
+    QByteArray body = QByteArray::fromRawData(
+        content.constData() + pos + recordHeaderSize, length);
+    pos += recordHeaderSize + length;
+    ++mStoreRecords;
+
+    if (qChecksum(body.constData(), length) != checksum) {
+      damaged = true;
+      continue;
+    }
+
+    QDataStream bodyStream(body);
+    bodyStream.setVersion(QDataStream::Qt_5_2);
+    quint8 recordType;
+    QUuid uniqueId;
+    bodyStream >> recordType >> uniqueId;
+
+    int index = positions.value(uniqueId, -1);
+
+    if (recordType == PutRecord) {
+      JobOptions *jo = new JobOptions();
+      try {
+        bodyStream >> *jo;
+      } catch (SerializationException &ex) {
+        delete jo;
+        damaged = true;
+        continue;
+      }
+
+      if (index >= 0) {
+        delete tasks[index];
+        tasks[index] = jo;
+      } else {
+        positions.insert(uniqueId, tasks.count());
+        tasks.append(jo);
+      }
+    } else if (recordType == RemoveRecord && index >= 0) {
+      // removed from list after whole file is read to keep positions valid
+      delete tasks[index];
+      tasks[index] = nullptr;
+      positions.remove(uniqueId);
+    }
   }
 
-  file->close();
-  delete file;
+  file.unmap(data);
+  file.close();
 
-  emit tasksListUpdated();
+  tasks.removeAll(nullptr);
+
+  if (damaged || pos < size) {
+    CompactStore();
+  }
+
+  return true;
+}
+
+bool ListOfJobOptions::AppendToStore(quint8 recordType, JobOptions *jo) {
+
+  // too many outdated records - rewrite store with current tasks only
+  if (mStoreRecords >= 2 * tasks.count() + 100) {
+    return CompactStore();
+  }
+
+  QFile file(GetPersistenceFilePath(storeFileName));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    return false;
+  }
+
+  if (file.size() == 0) {
+    file.write(makeStoreHeader());
+  }
+
+  QByteArray record = makeStoreRecord(recordType, jo);
+  bool written = (file.write(record) == record.size()) && file.flush();
+  file.close();
+
+  ++mStoreRecords;
+  return written;
+}
+
+bool ListOfJobOptions::CompactStore() {
+  QSaveFile fileToSave(GetPersistenceFilePath(storeFileName));
+
+  if (!fileToSave.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  fileToSave.write(makeStoreHeader());
+  for (JobOptions *it : tasks) {
+    fileToSave.write(makeStoreRecord(PutRecord, it));
+  }
 
+  mStoreRecords = tasks.count();
   return fileToSave.commit();
 }
 
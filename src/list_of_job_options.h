@@ -14,16 +14,30 @@ public:
   bool Persist(JobOptions *jo);
   bool Forget(JobOptions *jo);
   QList<JobOptions *> &getTasks() { return tasks; }
+  // nullptr when there is no such task
+  JobOptions *getTask(const QString &uniqueId) const;
 
 signals:
   void tasksListUpdated();
 
 private:
   static ListOfJobOptions *SavedJobOptions;
+  // tasks.bin - all tasks in one stream, only read to migrate old data
   static const QString persistenceFileName;
+  // tasks.db - checksummed records appended on every change
+  static const QString storeFileName;
   static bool RestoreFromUserData(ListOfJobOptions &dataIn);
+  static QString GetPersistenceFilePath(const QString &fileName);
   static QFile *GetPersistenceFile(QIODevice::OpenModeFlag mode);
 
   QList<JobOptions *> tasks;
-  bool PersistToUserData();
+  // tasks by uniqueId
+  QHash<QUuid, JobOptions *> index;
+  void rebuildIndex();
+
+  // records in store file incl. outdated ones, used to decide compaction
+  int mStoreRecords = 0;
+  bool RestoreFromStore();
+  bool AppendToStore(quint8 recordType, JobOptions *jo);
+  bool CompactStore();
 };
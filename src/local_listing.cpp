@@ -0,0 +1,148 @@
+#include "local_listing.h"
+#include "item_model.h"
+#ifndef Q_OS_WIN
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+// the same format as rclone lsd and lsl print
+QString modifiedString(qint64 secsSinceEpoch) {
+  return QDateTime::fromMSecsSinceEpoch(secsSinceEpoch * 1000)
+      .toString("yyyy-MM-dd HH:mm:ss");
+}
+
+} // namespace
+
+LocalListing::LocalListing(const QString &path, bool showHidden)
+    : mPath(path), mShowHidden(showHidden) {
+  setAutoDelete(false);
+}
+
+LocalListing::~LocalListing() { qDeleteAll(mItems); }
+
+QVector<Item *> LocalListing::takeItems() {
+  QVector<Item *> items;
+  items.swap(mItems);
+  return items;
+}
+
+void LocalListing::run() {
+
+#ifdef Q_OS_WIN
+  // FindFirstFile already returns size and time so QFileInfo needs no stat
+  QDirIterator it(mPath, QDir::AllEntries | QDir::NoDotAndDotDot |
+                             QDir::Hidden | QDir::System);
+  while (it.hasNext()) {
+    it.next();
+    QFileInfo info = it.fileInfo();
+    if (!mShowHidden && info.fileName().startsWith('.')) {
+      continue;
+    }
+
+    // symlinks and junctions are skipped like rclone does without --links,
+    // .lnk shortcuts are regular files for rclone
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    if (info.isSymbolicLink() || info.isJunction()) {
+      continue;
+    }
+#else
+    if (info.isSymLink() &&
+        info.suffix().compare("lnk", Qt::CaseInsensitive) != 0) {
+      continue;
+    }
+#endif
+
+    Item *item = new Item();
+    item->isFolder = info.isDir();
+    item->name = info.fileName();
+    item->modified = modifiedString(info.lastModified().toMSecsSinceEpoch() /
+                                    1000);
+    item->size = item->isFolder ? 0 : quint64(info.size());
+    mItems.append(item);
+  }
+#else
+  DIR *dir = opendir(QFile::encodeName(mPath).constData());
+  if (dir != nullptr) {
+    int fd = dirfd(dir);
+    while (struct dirent *entry = readdir(dir)) {
+      const char *name = entry->d_name;
+      if (qstrcmp(name, ".") == 0 || qstrcmp(name, "..") == 0 ||
+          (!mShowHidden && name[0] == '.')) {
+        continue;
+      }
+
+      // symlinks are skipped like rclone does without --links
+      struct stat st;
+      if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0 ||
+          S_ISLNK(st.st_mode) ||
+          !(S_ISDIR(st.st_mode) || S_ISREG(st.st_mode))) {
+        continue;
+      }
+
+      Item *item = new Item();
+      item->isFolder = S_ISDIR(st.st_mode);
+      item->name = QFile::decodeName(name);
+      item->modified = modifiedString(st.st_mtime);
+      item->size = item->isFolder ? 0 : quint64(st.st_size);
+      mItems.append(item);
+    }
+    closedir(dir);
+  }
+#endif
+
+  emit finished();
+}
+
+LocalVolumes *LocalVolumes::Volumes = nullptr;
+
+LocalVolumes::LocalVolumes() {
+  qRegisterMetaType<QHash<QString, QString>>();
+
+  QObject::connect(this, &LocalVolumes::found, this,
+                   [=](const QHash<QString, QString> &names) {
+                     mNames = names;
+                     mRunning = false;
+                     mReady.storeRelease(1);
+                     emit ready();
+                   },
+                   Qt::QueuedConnection);
+}
+
+LocalVolumes *LocalVolumes::getInstance() {
+  if (Volumes == nullptr) {
+    Volumes = new LocalVolumes();
+  }
+  return Volumes;
+}
+
+void LocalVolumes::request() {
+  if (mRunning) {
+    return;
+  }
+  mRunning = true;
+
+  class Lookup : public QRunnable {
+  public:
+    explicit Lookup(LocalVolumes *volumes) : mVolumes(volumes) {}
+
+    void run() override {
+      // QStorageInfo::mountedVolumes is slow :(
+      QHash<QString, QString> names;
+      for (const auto &volume : QStorageInfo::mountedVolumes()) {
+        if (!volume.name().isEmpty()) {
+          names.insert(volume.rootPath(), volume.name());
+        }
+      }
+      // names tabs are reading are replaced on GUI thread
+      emit mVolumes->found(names);
+    }
+
+  private:
+    LocalVolumes *mVolumes;
+  };
+
+  QThreadPool::globalInstance()->start(new Lookup(this));
+}
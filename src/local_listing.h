@@ -0,0 +1,59 @@
+#pragma once
+
+#include "pch.h"
+
+struct Item;
+
+// lists one local folder in-process on global thread pool instead of
+// starting rclone lsd and lsl, finished is emitted from the pool thread
+class LocalListing : public QObject, public QRunnable {
+  Q_OBJECT
+public:
+  LocalListing(const QString &path, bool showHidden);
+  ~LocalListing();
+
+  void run() override;
+
+  // folders and files with name, size and modified set - caller owns them
+  QVector<Item *> takeItems();
+
+signals:
+  void finished();
+
+private:
+  QString mPath;
+  bool mShowHidden;
+  QVector<Item *> mItems;
+};
+
+// mounted volume names by root path, looked up on global thread pool and
+// shared by all remote tabs
+class LocalVolumes : public QObject {
+  Q_OBJECT
+
+protected:
+  ~LocalVolumes() = default;
+  LocalVolumes();
+
+public:
+  static LocalVolumes *getInstance();
+
+  // starts lookup unless one is running, every opened local tab looks up
+  // volumes mounted since the last one
+  void request();
+  bool isReady() const { return mReady.loadAcquire() != 0; }
+  // valid once ready, replaced on GUI thread before every ready
+  const QHash<QString, QString> &getNames() const { return mNames; }
+
+signals:
+  void ready();
+  // from lookup thread
+  void found(const QHash<QString, QString> &names);
+
+private:
+  static LocalVolumes *Volumes;
+
+  bool mRunning = false;
+  QAtomicInt mReady;
+  QHash<QString, QString> mNames;
+};
@@ -1,3 +1,4 @@
+#include "headless.h"
 #include "main_window.h"
 #include "utils.h"
 
@@ -73,12 +74,28 @@ int main(int argc, char *argv[]) {
   }
 #endif
 
-  QApplication app(argc, argv);
+  // rclone-browser --control <command> talks to headless instance
+  bool headless = false;
+  for (int i = 1; i < argc; i++) {
+    if (qstrcmp(argv[i], "--control") == 0) {
+      return RunHeadlessControl(argc, argv);
+    }
+    if (qstrcmp(argv[i], "--headless") == 0) {
+      headless = true;
+    }
+  }
+
+  // headless instance doesn't load any GUI
+  std::unique_ptr<QCoreApplication> app(
+      headless ? new QCoreApplication(argc, argv)
+               : new QApplication(argc, argv));
 
-  //  app.setApplicationDisplayName("Rclone Browser");
-  app.setApplicationName("rclone-browser");
-  app.setOrganizationName("rclone-browser");
-  app.setWindowIcon(QIcon(":/icons/icon.png"));
+  //  app->setApplicationDisplayName("Rclone Browser");
+  app->setApplicationName("rclone-browser");
+  app->setOrganizationName("rclone-browser");
+  if (!headless) {
+    QApplication::setWindowIcon(QIcon(":/icons/icon.png"));
+  }
 
 // initialize SSL libraries
 // see: https://github.com/linuxdeploy/linuxdeploy-plugin-qt/issues/57
@@ -228,6 +245,42 @@ int main(int argc, char *argv[]) {
     settings->setValue("Settings/preemptiveLoadingLevel", "0");
   }
 
+  // how many transfers can run when processing the queue
+  if (!(settings->contains("Settings/queueSlots"))) {
+    settings->setValue("Settings/queueSlots", "1");
+  };
+
+  // max queued tasks using the same remote at once (0 - no limit)
+  if (!(settings->contains("Settings/queueRemoteCap"))) {
+    settings->setValue("Settings/queueRemoteCap", "0");
+  };
+
+  // order of waiting queue tasks: manual, shortest, window
+  if (!(settings->contains("Settings/queueOrder"))) {
+    settings->setValue("Settings/queueOrder", "manual");
+  };
+
+  // end of maintenance window used by window queue order
+  if (!(settings->contains("Settings/queueWindowEnd"))) {
+    settings->setValue("Settings/queueWindowEnd", "06:00");
+  };
+
+  // scheduled runs missed e.g. during sleep: skip, once
+  if (!(settings->contains("Settings/schedulerCatchUp"))) {
+    settings->setValue("Settings/schedulerCatchUp", "skip");
+  };
+
+  // max seconds scheduled runs are spread after their time (0 - off)
+  if (!(settings->contains("Settings/schedulerJitter"))) {
+    settings->setValue("Settings/schedulerJitter", "0");
+  };
+
+  // running transfers per remote after which scheduled runs go to the queue
+  // (0 - no limit)
+  if (!(settings->contains("Settings/schedulerRemoteCap"))) {
+    settings->setValue("Settings/schedulerRemoteCap", "0");
+  };
+
   // during first run the queueScript key might not exist
   if (!(settings->contains("Settings/queueScript"))) {
     settings->setValue("Settings/queueScript", "");
@@ -269,13 +322,20 @@ int main(int argc, char *argv[]) {
     settings->setValue("Settings/rcPortStartWin", "49700");
   };
 
+  // first RC port tried for transfers (used for live bandwidth control)
+  if (!(settings->contains("Settings/rcPortStartTransfer"))) {
+    settings->setValue("Settings/rcPortStartTransfer", "50700");
+  };
+
   // set application font size
-  int fontsize = 0;
-  fontsize = (settings->value("Settings/fontSize").toInt());
+  if (!headless) {
+    int fontsize = 0;
+    fontsize = (settings->value("Settings/fontSize").toInt());
 
-  QFont defaultFont = QApplication::font();
-  defaultFont.setPointSize(defaultFont.pointSize() + fontsize);
-  qApp->setFont(defaultFont);
+    QFont defaultFont = QApplication::font();
+    defaultFont.setPointSize(defaultFont.pointSize() + fontsize);
+    QApplication::setFont(defaultFont);
+  }
 
   // enforce one instance of Rclone Browser per user
   QString tmpDir;
@@ -338,7 +398,10 @@ int main(int argc, char *argv[]) {
     tempfile.remove();
   } else {
     // folder has no write access
-    if (IsPortableMode()) {
+    if (headless) {
+      qCritical("You need write access to this folder: %s",
+                qPrintable(QDir(tmpDir).absolutePath()));
+    } else if (IsPortableMode()) {
       QMessageBox msgBox;
       msgBox.setIcon(QMessageBox::Warning);
       msgBox.setText("You need write "
@@ -400,17 +463,26 @@ int main(int argc, char *argv[]) {
 
   if (!lockFile.tryLock(100)) {
     // if already running display warning and quit
-    QMessageBox msgBox;
-    msgBox.setIcon(QMessageBox::Warning);
-    msgBox.setText("Rclone Browser is already running."
-                   "\r\n\nOnly one instance is allowed.");
-    msgBox.exec();
+    if (headless) {
+      qCritical("Rclone Browser is already running. Only one instance is "
+                "allowed.");
+    } else {
+      QMessageBox msgBox;
+      msgBox.setIcon(QMessageBox::Warning);
+      msgBox.setText("Rclone Browser is already running."
+                     "\r\n\nOnly one instance is allowed.");
+      msgBox.exec();
+    }
     return static_cast<int>(
         0x80004004); // exit immediately if another instance is running
   }
 
+  if (headless) {
+    return RunHeadless();
+  }
+
   MainWindow w;
   w.show();
 
-  return app.exec();
+  return app->exec();
 }
@@ -1,11 +1,15 @@
 #include "main_window.h"
+#include "job_history.h"
+#include "job_history_dialog.h"
 #include "job_options.h"
 #include "job_widget.h"
 #include "list_of_job_options.h"
 #include "mount_dialog.h"
 #include "mount_widget.h"
 #include "preferences_dialog.h"
+#include "queue_policy.h"
 #include "remote_widget.h"
+#include "scheduler_calendar_dialog.h"
 #include "scheduler_widget.h"
 #include "stream_widget.h"
 #include "transfer_dialog.h"
@@ -20,7 +24,17 @@
 
 MainWindow::MainWindow() {
 
+  mStartupTimer.start();
+
   ui.setupUi(this);
+  traceStartup("user interface created");
+
+  mQueueFileWriter =
+      new DeferredFileWriter(GetConfigDir().absoluteFilePath("queue.conf"),
+                             [=]() { return getQueueFileContent(); }, 500, this);
+  mSchedulerFileWriter = new DeferredFileWriter(
+      GetConfigDir().absoluteFilePath("scheduler.conf"),
+      [=]() { return getSchedulerFileContent(); }, 500, this);
 
 #ifdef Q_OS_MACOS
   // macOS power saving control object
@@ -245,6 +259,8 @@ MainWindow::MainWindow() {
       QIcon(":media/images/qbutton_icons/run" + img_add + ".png"));
   ui.actionStopScheduler->setIcon(
       QIcon(":media/images/qbutton_icons/stop" + img_add + ".png"));
+  ui.actionSchedulerCalendar->setIcon(
+      QIcon(":media/images/qbutton_icons/info" + img_add + ".png"));
 
   QPixmap arrowDownPixmap(":media/images/qbutton_icons/arrowdown" + img_add +
                           ".png");
@@ -288,6 +304,7 @@ MainWindow::MainWindow() {
   ui.buttonUpQueue->setDefaultAction(ui.actionUpQueue);
   ui.buttonStartScheduler->setDefaultAction(ui.actionStartScheduler);
   ui.buttonStopScheduler->setDefaultAction(ui.actionStopScheduler);
+  ui.buttonSchedulerCalendar->setDefaultAction(ui.actionSchedulerCalendar);
 
   // overwrite button text, we want different menu name and different conextual
   // menu
@@ -376,6 +393,8 @@ MainWindow::MainWindow() {
     ui.buttonStopScheduler->setMinimumWidth(button_width);
     ui.buttonStartScheduler->setIconSize(QSize(icon_w, icon_h));
     ui.buttonStartScheduler->setMinimumWidth(button_width);
+    ui.buttonSchedulerCalendar->setIconSize(QSize(icon_w, icon_h));
+    ui.buttonSchedulerCalendar->setMinimumWidth(button_width);
     ui.buttonSortByTime->setIconSize(QSize(icon_w, icon_h));
     ui.buttonSortByTime->setMinimumWidth(button_width);
     ui.buttonSortByStatus->setIconSize(QSize(icon_w, icon_h));
@@ -428,6 +447,8 @@ MainWindow::MainWindow() {
       ui.buttonStopScheduler->setMinimumWidth(button_width);
       ui.buttonStartScheduler->setToolButtonStyle(Qt::ToolButtonTextOnly);
       ui.buttonStartScheduler->setMinimumWidth(button_width);
+      ui.buttonSchedulerCalendar->setToolButtonStyle(Qt::ToolButtonTextOnly);
+      ui.buttonSchedulerCalendar->setMinimumWidth(button_width);
       ui.buttonSortByTime->setToolButtonStyle(Qt::ToolButtonTextOnly);
       ui.buttonSortByTime->setMinimumWidth(button_width);
       ui.buttonSortByStatus->setToolButtonStyle(Qt::ToolButtonTextOnly);
@@ -479,6 +500,8 @@ MainWindow::MainWindow() {
       ui.buttonStopScheduler->setIconSize(QSize(icon_w, icon_h));
       ui.buttonStartScheduler->setToolButtonStyle(Qt::ToolButtonIconOnly);
       ui.buttonStartScheduler->setIconSize(QSize(icon_w, icon_h));
+      ui.buttonSchedulerCalendar->setToolButtonStyle(Qt::ToolButtonIconOnly);
+      ui.buttonSchedulerCalendar->setIconSize(QSize(icon_w, icon_h));
       ui.buttonSortByTime->setToolButtonStyle(Qt::ToolButtonIconOnly);
       ui.buttonSortByTime->setIconSize(QSize(icon_w, icon_h));
       ui.buttonSortByStatus->setToolButtonStyle(Qt::ToolButtonIconOnly);
@@ -502,6 +525,7 @@ MainWindow::MainWindow() {
   ui.actionConfig->setStatusTip("rclone config");
   ui.actionOpen->setStatusTip("Open remote");
   ui.preferences->setStatusTip("Rclone Browser preferences (ALT-p)");
+  ui.history->setStatusTip("Show history of finished transfers");
 
   ui.actionStopAllTransfers->setStatusTip("Stop all running transfer jobs");
   ui.actionCleanNotRunning->setStatusTip("Remove all not running jobs");
@@ -511,6 +535,7 @@ MainWindow::MainWindow() {
   ui.actionStop->setStatusTip("Stop all selected tasks");
 
   ui.actionEdit->setStatusTip("Edit selected task");
+  ui.actionHistory->setStatusTip("Show history of selected task");
   ui.actionDelete->setStatusTip(
       "Delete selected tasks - only not running tasks can be deleted.");
 
@@ -532,6 +557,8 @@ MainWindow::MainWindow() {
   ui.buttonStopScheduler->setStatusTip("Stop scheduler");
   ui.buttonStartScheduler->setStatusTip(
       "Start all previously active schedulers");
+  ui.buttonSchedulerCalendar->setStatusTip(
+      "Show runs of active schedulers in the next 30 days");
 
   ui.buttonStartScheduler->setEnabled(false);
   ui.buttonStopAllJobs->setEnabled(false);
@@ -548,7 +575,16 @@ MainWindow::MainWindow() {
   ui.labelSchedulerInfoStop->hide();
 
   QObject::connect(ui.preferences, &QAction::triggered, this, [=]() {
-    PreferencesDialog dialog(this);
+    // created on first use and kept for later
+    if (mPreferencesDialog == nullptr) {
+      mPreferencesDialog = new PreferencesDialog(this);
+    } else if (mPreferencesDialog->isVisible()) {
+      return;
+    } else {
+      mPreferencesDialog->loadSettings();
+    }
+
+    PreferencesDialog &dialog = *mPreferencesDialog;
     if (dialog.exec() == QDialog::Accepted) {
       auto settings = GetSettings();
       settings->setValue("Settings/rclone", dialog.getRclone().trimmed());
@@ -616,6 +652,19 @@ MainWindow::MainWindow() {
       settings->setValue("Settings/preemptiveLoadingLevel",
                          dialog.getPreemptiveLoadingLevel().trimmed());
 
+      settings->setValue("Settings/queueSlots", dialog.getQueueSlots());
+      settings->setValue("Settings/queueRemoteCap",
+                         dialog.getQueueRemoteCap());
+      settings->setValue("Settings/queueOrder", dialog.getQueueOrder());
+      settings->setValue("Settings/queueWindowEnd",
+                         dialog.getQueueWindowEnd());
+      settings->setValue("Settings/schedulerCatchUp",
+                         dialog.getSchedulerCatchUp());
+      settings->setValue("Settings/schedulerJitter",
+                         dialog.getSchedulerJitter());
+      settings->setValue("Settings/schedulerRemoteCap",
+                         dialog.getSchedulerRemoteCap());
+
       settings->setValue("Settings/queueScript",
                          dialog.getQueueScript().trimmed());
       settings->setValue("Settings/transferOnScript",
@@ -629,6 +678,8 @@ MainWindow::MainWindow() {
       settings->setValue("Settings/jobLastFinishedScriptRun",
                          dialog.getJobLastFinishedScriptRun());
 
+      ReloadSettingsSnapshot();
+
       SetRclone(dialog.getRclone());
       SetRcloneConf(dialog.getRcloneConf());
       mFirstTime = true;
@@ -640,6 +691,9 @@ MainWindow::MainWindow() {
       mSoundNotif = dialog.getSoundNotif();
 
       mSystemTray.setVisible(mAlwaysShowInTray);
+
+      // number of queue slots or queue order could change
+      runQueue();
     }
   });
 
@@ -856,6 +910,9 @@ MainWindow::MainWindow() {
           menu.addSeparator();
           if (items.count() == 1) {
             menu.addAction(ui.actionEdit);
+            if (!isMount) {
+              menu.addAction(ui.actionHistory);
+            }
           }
           if (!isRunning && !isScheduled) {
             menu.addAction(ui.actionDelete);
@@ -864,16 +921,44 @@ MainWindow::MainWindow() {
         }
       });
 
-  QObject::connect(ui.queueListWidget, &QWidget::customContextMenuRequested,
-                   this, [=](const QPoint &pos) {
-                     QMenu menu;
-                     menu.addAction(ui.actionUpQueue);
-                     menu.addAction(ui.actionDownQueue);
-                     menu.addSeparator();
-                     menu.addAction(ui.actionRemoveFromQueue);
-                     menu.exec(
-                         ui.queueListWidget->viewport()->mapToGlobal(pos));
-                   });
+  QObject::connect(
+      ui.queueListWidget, &QWidget::customContextMenuRequested, this,
+      [=](const QPoint &pos) {
+        int row = ui.queueListWidget->currentRow();
+        JobOptionsListWidgetItem *item =
+            static_cast<JobOptionsListWidgetItem *>(
+                ui.queueListWidget->item(row));
+
+        QMenu menu;
+        menu.addAction(ui.actionUpQueue);
+        menu.addAction(ui.actionDownQueue);
+        menu.addSeparator();
+
+        // optional dependency on previous queue entry
+        QAction *afterPrevious = menu.addAction("Run after previous task");
+        afterPrevious->setCheckable(true);
+        afterPrevious->setEnabled(item != nullptr && row > 0 &&
+                                  row >= mQueueRunningCount);
+        afterPrevious->setChecked(item != nullptr &&
+                                  !item->GetDependsOn().isEmpty());
+        menu.addSeparator();
+        menu.addAction(ui.actionRemoveFromQueue);
+
+        if (menu.exec(ui.queueListWidget->viewport()->mapToGlobal(pos)) ==
+                afterPrevious &&
+            item != nullptr) {
+          if (afterPrevious->isChecked()) {
+            JobOptionsListWidgetItem *previous =
+                static_cast<JobOptionsListWidgetItem *>(
+                    ui.queueListWidget->item(row - 1));
+            setQueueDependency(item, previous->GetRequestId());
+          } else {
+            setQueueDependency(item, "");
+          }
+          saveQueueFile();
+          runQueue();
+        }
+      });
 
   QObject::connect(ui.actionCleanNotRunning, &QAction::triggered, this, [=]() {
     int jobsCount = ((ui.jobs->count() - 2) / 2 - mJobCount);
@@ -927,27 +1012,17 @@ MainWindow::MainWindow() {
         // (triggered by stopping tasks)
         bool queueActive = false;
 
-        if ((mQueueStatus == true) && mQueueTaskRunning &&
-            (ui.queueListWidget->count() > 0)) {
+        if ((mQueueStatus == true) && mQueueRunningCount > 0) {
           queueActive = true;
           mQueueStatus = false;
-          /// remove top task from queue + save it
-          ui.queueListWidget->takeItem(0);
-          --mQueueCount;
-          saveQueueFile();
-
-          if (mQueueCount == 0) {
-            ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-          } else {
-
-            if (!mQueueTaskRunning) {
-              ui.tabs->setTabText(3,
-                                  QString("Queue (%1)>>(0)").arg(mQueueCount));
-            } else {
-              ui.tabs->setTabText(
-                  3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-            }
+          /// remove running tasks from queue + save it
+          while (mQueueRunningCount > 0) {
+            delete ui.queueListWidget->takeItem(0);
+            --mQueueRunningCount;
+            --mQueueCount;
           }
+          saveQueueFile();
+          updateQueueTabText();
           setQueueButtons();
         }
 
@@ -977,20 +1052,9 @@ MainWindow::MainWindow() {
             }
           }
 
-          if (ui.queueListWidget->count() > 0) {
-            // start task
-            // no transfer job is running as we just stopped all - we can start
-            // without checking other running jobs
-            JobOptionsListWidgetItem *item =
-                static_cast<JobOptionsListWidgetItem *>(
-                    ui.queueListWidget->item(0));
-            mQueueTaskRunning = true;
-            runItem(item, "queue", item->GetRequestId());
-            ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-            setQueueButtons();
-          } else {
-            mQueueTaskRunning = false;
-          }
+          // no transfer job is running as we just stopped all - queue can
+          // use all its slots
+          runQueue();
         }
       }
     }
@@ -1018,6 +1082,23 @@ MainWindow::MainWindow() {
     }
   });
 
+  QObject::connect(ui.history, &QAction::triggered, this, [=]() {
+    JobHistoryDialog dialog(QString(), this);
+    dialog.exec();
+  });
+
+  QObject::connect(ui.actionHistory, &QAction::triggered, this, [=]() {
+    auto items = ui.tasksListWidget->selectedItems();
+    if (items.count() != 1) {
+      return;
+    }
+
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(items.at(0));
+    JobHistoryDialog dialog(item->GetData()->uniqueId.toString(), this);
+    dialog.exec();
+  });
+
   QObject::connect(ui.actionEdit, &QAction::triggered, this, [=]() {
     auto items = ui.tasksListWidget->selectedItems();
 
@@ -1354,6 +1435,9 @@ MainWindow::MainWindow() {
     sortJobs();
   });
 
+  QObject::connect(ui.actionSchedulerCalendar, &QAction::triggered, this,
+                   [=]() { showSchedulerCalendar(); });
+
   //!!!  QObject::connect(ui.actionSortByStatus
   QObject::connect(ui.actionSortByStatus, &QAction::triggered, this, [=]() {
     ui.buttonSortByTime->setStyleSheet("QToolButton {border: 0;}");
@@ -1501,9 +1585,6 @@ MainWindow::MainWindow() {
       }
     }
 
-    // if queue is empty we have to try to start first task
-    bool isQueueEmpty = (ui.queueListWidget->count() == 0);
-
     if (items.count() > 0) {
       int button = QMessageBox::question(
           this, "Add to the queue",
@@ -1514,77 +1595,12 @@ MainWindow::MainWindow() {
 
       if (button == QMessageBox::Yes) {
 
-        mQueueCount = mQueueCount + items.count();
-
+        QList<JobOptions *> tasks;
         foreach (auto i, items) {
-          JobOptionsListWidgetItem *item =
-              static_cast<JobOptionsListWidgetItem *>(i);
-
-          JobOptions *jo = item->GetData();
-
-          QIcon jobIcon;
-
-          if (jo->jobType == JobOptions::JobType::Download) {
-            if (jo->operation == JobOptions::Mount) {
-              jobIcon = mMountIcon;
-            } else {
-              jobIcon = mDownloadIcon;
-            }
-          }
-          if (jo->jobType == JobOptions::JobType::Upload) {
-            jobIcon = mUploadIcon;
-          }
-
-          JobOptionsListWidgetItem *newitem = new JobOptionsListWidgetItem(
-              jo, jobIcon, jo->description, QUuid::createUuid().toString());
-
-          ui.queueListWidget->addItem(newitem);
-        }
-
-        if (ui.queueListWidget->count() > 0) {
-          ui.buttonPurgeQueue->setEnabled(true);
-        } else {
-          ui.buttonPurgeQueue->setEnabled(false);
+          tasks << static_cast<JobOptionsListWidgetItem *>(i)->GetData();
         }
-        // save new queue to file
-        saveQueueFile();
+        enqueueTasks(tasks);
         ui.queueListWidget->setFocus();
-      } else {
-        // user pressed No
-        return;
-      }
-    }
-
-    // if queue was empty we start first task if queue is running and there is
-    // no other transfer job running
-    if (mQueueStatus && isQueueEmpty && (mTransferJobCount == 0)) {
-
-      if (mQueueCount > 0) {
-
-        JobOptionsListWidgetItem *item =
-            static_cast<JobOptionsListWidgetItem *>(
-                ui.queueListWidget->item(0));
-
-        runItem(item, "queue", item->GetRequestId());
-        ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-        mQueueTaskRunning = true;
-        ui.tabs->setTabText(3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-      }
-
-    } else {
-
-      if (mQueueStatus) {
-
-        if (mQueueTaskRunning) {
-          ui.tabs->setTabText(3,
-                              QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-        } else {
-
-          ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-        }
-
-      } else {
-        ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
       }
     }
   });
@@ -1596,68 +1612,15 @@ MainWindow::MainWindow() {
     auto settings = GetSettings();
     settings->setValue("Settings/queueStatus", "true");
 
-    ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-
     ui.buttonStopQueue->setEnabled(true);
     ui.buttonStartQueue->setEnabled(false);
 
-    ui.buttonPurgeQueue->setEnabled(false);
-
-    if (mQueueCount > 1) {
-      ui.buttonPurgeQueue->setEnabled(true);
-    } else {
-      ui.buttonPurgeQueue->setEnabled(false);
-    }
-
-    if (ui.queueListWidget->currentRow() == 0 ||
-        ui.queueListWidget->currentRow() == ui.queueListWidget->count() - 1) {
-      ui.buttonDownQueue->setEnabled(false);
-    } else {
-      ui.buttonDownQueue->setEnabled(true);
-    }
-
-    if (ui.queueListWidget->currentRow() == 1 ||
-        ui.queueListWidget->currentRow() == 0) {
-      ui.buttonUpQueue->setEnabled(false);
-    } else {
-      ui.buttonUpQueue->setEnabled(true);
-    }
-
-    if (ui.queueListWidget->currentRow() == 0) {
-
-      ui.buttonRemoveFromQueue->setEnabled(false);
-      ui.buttonUpQueue->setEnabled(false);
-      ui.buttonDownQueue->setEnabled(false);
-
-    } else {
-      ui.buttonRemoveFromQueue->setEnabled(true);
-    }
-
-    if (mQueueCount == 0) {
-      ui.buttonRemoveFromQueue->setEnabled(false);
-      ui.buttonPurgeQueue->setEnabled(false);
-      ui.buttonUpQueue->setEnabled(false);
-      ui.buttonDownQueue->setEnabled(false);
-    }
-
     ui.labelQueueInfoStart->setText("Queue is running.");
     ui.labelQueueInfoStart->show();
     ui.labelQueueInfoStop->hide();
 
-    // if not empty and nothing else running try to start first task
-    if (mQueueCount > 0 && mTransferJobCount == 0) {
-      JobOptionsListWidgetItem *item =
-          static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(0));
-
-      // start only when not running already
-      //      if (!isAlreadyRunning) {
-      mQueueTaskRunning = true;
-      runItem(item, "queue", item->GetRequestId());
-      ui.tabs->setTabText(3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-      ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-      ui.queueListWidget->item(0)->setSelected(false);
-      //      }
-    }
+    // start tasks while there are free slots
+    runQueue();
   });
 
   QObject::connect(ui.actionStopQueue, &QAction::triggered, this, [=]() {
@@ -1666,10 +1629,6 @@ MainWindow::MainWindow() {
     auto settings = GetSettings();
     settings->setValue("Settings/queueStatus", "false");
 
-    if (ui.queueListWidget->count() > 0) {
-      ui.queueListWidget->item(0)->setBackground(QBrush());
-    }
-
     ui.buttonStopQueue->setEnabled(false);
     ui.buttonStartQueue->setEnabled(true);
     ui.buttonPurgeQueue->setEnabled(true);
@@ -1680,14 +1639,14 @@ MainWindow::MainWindow() {
       ui.buttonPurgeQueue->setEnabled(false);
       ui.buttonUpQueue->setEnabled(false);
       ui.buttonDownQueue->setEnabled(false);
-      ui.tabs->setTabText(3, QString("Queue"));
-    } else {
-      ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
     }
 
-    if (!(ui.queueListWidget->item(0) == nullptr)) {
+    // stop running queued tasks - they stay in the queue
+    QList<JobWidget *> queueTransfers;
+    for (int i = 0; i < mQueueRunningCount; i++) {
       JobOptionsListWidgetItem *item =
-          static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(0));
+          static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+      item->setBackground(QBrush());
 
       JobOptions *jo = item->GetData();
 
@@ -1697,17 +1656,23 @@ MainWindow::MainWindow() {
         if (auto transfer = qobject_cast<JobWidget *>(widget)) {
 
           if ((transfer->getUniqueID() == jo->uniqueId.toString()) &&
-              (transfer->isRunning)) {
-
-            if (transfer->getRequestId() == item->GetRequestId()) {
-
-              emit transfer->cancel();
-            }
+              (transfer->isRunning) &&
+              (transfer->getRequestId() == item->GetRequestId())) {
+            queueTransfers << transfer;
           }
         }
       }
     }
 
+    mDoNotSort = true;
+    for (auto transfer : queueTransfers) {
+      emit transfer->cancel();
+    }
+    mDoNotSort = false;
+    sortJobs();
+
+    updateQueueTabText();
+
     ui.labelQueueInfoStop->setText("Queue is not running.");
     ui.labelQueueInfoStop->show();
     ui.labelQueueInfoStart->hide();
@@ -1725,310 +1690,76 @@ MainWindow::MainWindow() {
 
       if (button == QMessageBox::Yes) {
 
-        int itemsCount = ui.queueListWidget->count();
-        for (int i = 0; i < itemsCount; i++) {
-
-          if (mQueueStatus && mQueueTaskRunning) {
-            if (i != 0) {
-              --mQueueCount;
-
-              JobOptionsListWidgetItem *item_queue =
-                  static_cast<JobOptionsListWidgetItem *>(
-                      ui.queueListWidget->item(1));
-
-              QString requestId = item_queue->GetRequestId();
-              // notify schedulers
-              int schedulersCount = ui.schedulers->count();
-              for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-                QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-                if (auto scheduler =
-                        qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-                  scheduler->updateTaskStatus(requestId,
-                                              "removed from the queue");
-
-                  if (scheduler->getSchedulerRequestId() ==
-                      item_queue->GetRequestId()) {
-
-                    mRunningSchedulersCount--;
-                    ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                               .arg(mSchedulersCount)
-                                               .arg(mRunningSchedulersCount));
-                  }
-                }
-              }
-
-              ui.queueListWidget->takeItem(1);
-            }
-          } else {
-            --mQueueCount;
-
-            JobOptionsListWidgetItem *item_queue =
-                static_cast<JobOptionsListWidgetItem *>(
-                    ui.queueListWidget->item(0));
-
-            QString requestId = item_queue->GetRequestId();
-            // notify schedulers
-            int schedulersCount = ui.schedulers->count();
-            for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-              QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-              if (auto scheduler =
-                      qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-                scheduler->updateTaskStatus(requestId,
-                                            "removed from the queue");
-
-                if (scheduler->getSchedulerRequestId() ==
-                    item_queue->GetRequestId()) {
-                  mRunningSchedulersCount--;
-                  ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                             .arg(mSchedulersCount)
-                                             .arg(mRunningSchedulersCount));
-                }
-              }
-            }
-
-            ui.queueListWidget->takeItem(0);
-          }
-
-          ui.buttonRemoveFromQueue->setEnabled(false);
-          ui.buttonPurgeQueue->setEnabled(false);
-          ui.buttonUpQueue->setEnabled(false);
-          ui.buttonDownQueue->setEnabled(false);
-        }
-      } else {
-        ui.queueListWidget->setFocus();
-      }
-    }
-
-    if (mQueueStatus) {
-
-      if (mQueueCount == 0) {
-        ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-      } else {
-
-        if (!mQueueTaskRunning) {
-          ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-        } else {
-          ui.tabs->setTabText(3,
-                              QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
+        // running tasks at the top of the queue stay
+        QList<int> rows;
+        for (int i = mQueueRunningCount; i < ui.queueListWidget->count(); i++) {
+          rows << i;
         }
-      }
+        removeQueueItems(rows);
 
-    } else {
-      if (mQueueCount != 0) {
-        ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
+        ui.buttonRemoveFromQueue->setEnabled(false);
+        ui.buttonPurgeQueue->setEnabled(false);
+        ui.buttonUpQueue->setEnabled(false);
+        ui.buttonDownQueue->setEnabled(false);
       } else {
-        ui.tabs->setTabText(3, QString("Queue"));
+        ui.queueListWidget->setFocus();
       }
     }
-
-    saveQueueFile();
   });
 
   QObject::connect(ui.actionRemoveFromQueue, &QAction::triggered, this, [=]() {
-    if (mQueueStatus) {
-
-      if (mQueueCount > 0) {
-
-        JobOptionsListWidgetItem *item_queue =
-            static_cast<JobOptionsListWidgetItem *>(
-                ui.queueListWidget->item(ui.queueListWidget->currentRow()));
-
-        QString requestId = item_queue->GetRequestId();
+    removeQueueItems(getSelectedQueueRows());
+  });
 
-        // notify schedulers
-        int schedulersCount = ui.schedulers->count();
-        for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-          QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-          if (auto scheduler =
-                  qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-            scheduler->updateTaskStatus(requestId, "removed from the queue");
+  QObject::connect(ui.actionDownQueue, &QAction::triggered, this, [=]() {
+    switchToManualQueueOrder();
+    moveQueueItems(getSelectedQueueRows(), 1);
+  });
 
-            if (scheduler->getSchedulerRequestId() == requestId) {
-              mRunningSchedulersCount--;
-              ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                         .arg(mSchedulersCount)
-                                         .arg(mRunningSchedulersCount));
-            }
-          }
-        }
+  QObject::connect(ui.actionUpQueue, &QAction::triggered, this, [=]() {
+    switchToManualQueueOrder();
+    moveQueueItems(getSelectedQueueRows(), -1);
+  });
 
-        --mQueueCount;
-        ui.queueListWidget->takeItem(ui.queueListWidget->currentRow());
+  QObject::connect(ui.queueListWidget, &QListWidget::itemChanged, this,
+                   [=]() { setQueueButtons(); });
 
-        if (ui.queueListWidget->currentRow() == 0 ||
-            ui.queueListWidget->currentRow() ==
-                ui.queueListWidget->count() - 1) {
-          ui.buttonDownQueue->setEnabled(false);
-        } else {
-          ui.buttonDownQueue->setEnabled(true);
-        }
+  QObject::connect(ui.queueListWidget, &QListWidget::itemClicked, this,
+                   [=]() { setQueueButtons(); });
 
-        if (ui.queueListWidget->currentRow() == 0 ||
-            ui.queueListWidget->currentRow() == 1) {
-          ui.buttonUpQueue->setEnabled(false);
-        } else {
-          ui.buttonUpQueue->setEnabled(true);
-        }
-      }
-      if (ui.queueListWidget->count() == 1) {
-        ui.buttonRemoveFromQueue->setEnabled(false);
-      }
-      if (mQueueCount == 0) {
-        ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-      } else {
+  QObject::connect(ui.queueListWidget, &QListWidget::currentItemChanged, this,
+                   [=]() { setQueueButtons(); });
 
-        if (!mQueueTaskRunning) {
-          ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-        } else {
-          ui.tabs->setTabText(3,
-                              QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-        }
-      }
+  QObject::connect(ui.queueListWidget, &QListWidget::itemSelectionChanged, this,
+                   [=]() { setQueueButtons(); });
 
-    } else {
+  QObject::connect(ListOfJobOptions::getInstance(),
+                   &ListOfJobOptions::tasksListUpdated, this,
+                   &MainWindow::listTasks);
 
-      --mQueueCount;
+  mUploadIcon = arrowUpIcon;
+  mDownloadIcon = arrowDownIcon;
+  mMountIcon = mount1Icon;
 
-      JobOptionsListWidgetItem *item_queue =
-          static_cast<JobOptionsListWidgetItem *>(
-              ui.queueListWidget->item(ui.queueListWidget->currentRow()));
+  // remove close button from these tabs
+  ui.tabs->tabBar()->setTabButton(0, QTabBar::RightSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(0, QTabBar::LeftSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(1, QTabBar::RightSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(1, QTabBar::LeftSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(2, QTabBar::RightSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(2, QTabBar::LeftSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(3, QTabBar::RightSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(3, QTabBar::LeftSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(4, QTabBar::RightSide, nullptr);
+  ui.tabs->tabBar()->setTabButton(4, QTabBar::LeftSide, nullptr);
 
-      QString requestId = item_queue->GetRequestId();
+  ui.tabs->setCurrentIndex(0);
 
-      // notify schedulers
-      int schedulersCount = ui.schedulers->count();
-      for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-        QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-        if (auto scheduler = qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-          scheduler->updateTaskStatus(requestId, "removed from the queue");
-
-          if (scheduler->getSchedulerRequestId() == requestId) {
-            mRunningSchedulersCount--;
-            ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                       .arg(mSchedulersCount)
-                                       .arg(mRunningSchedulersCount));
-          }
-        }
-      }
-
-      ui.queueListWidget->takeItem(ui.queueListWidget->currentRow());
-
-      if (ui.queueListWidget->currentRow() == ui.queueListWidget->count() - 1) {
-        ui.buttonDownQueue->setEnabled(false);
-      } else {
-        ui.buttonDownQueue->setEnabled(true);
-      }
-      if (ui.queueListWidget->currentRow() == 0) {
-        ui.buttonUpQueue->setEnabled(false);
-      } else {
-        ui.buttonUpQueue->setEnabled(true);
-      }
-
-      if (ui.queueListWidget->count() == 0) {
-
-        ui.buttonRemoveFromQueue->setEnabled(false);
-        ui.buttonPurgeQueue->setEnabled(false);
-        ui.buttonUpQueue->setEnabled(false);
-        ui.buttonDownQueue->setEnabled(false);
-        ui.tabs->setTabText(3, QString("Queue"));
-
-      } else {
-        ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-      }
-    }
-
-    saveQueueFile();
-  });
-
-  QObject::connect(ui.actionDownQueue, &QAction::triggered, this, [=]() {
-    auto item = ui.queueListWidget->takeItem(ui.queueListWidget->currentRow());
-    ui.queueListWidget->insertItem(ui.queueListWidget->currentRow() + 1, item);
-    ui.queueListWidget->setCurrentRow(ui.queueListWidget->row(item));
-
-    saveQueueFile();
-  });
-
-  QObject::connect(ui.actionUpQueue, &QAction::triggered, this, [=]() {
-    if (ui.queueListWidget->currentRow() == ui.queueListWidget->count() - 1) {
-      // last row needs special treatment
-      auto item =
-          ui.queueListWidget->takeItem(ui.queueListWidget->currentRow());
-      ui.queueListWidget->insertItem(ui.queueListWidget->currentRow(), item);
-      ui.queueListWidget->setCurrentRow(ui.queueListWidget->row(item));
-    } else {
-      auto item =
-          ui.queueListWidget->takeItem(ui.queueListWidget->currentRow());
-      ui.queueListWidget->insertItem(ui.queueListWidget->currentRow() - 1,
-                                     item);
-      ui.queueListWidget->setCurrentRow(ui.queueListWidget->row(item));
-    }
-
-    saveQueueFile();
-  });
-
-  QObject::connect(ui.queueListWidget, &QListWidget::itemChanged, this,
-                   [=]() { setQueueButtons(); });
-
-  QObject::connect(ui.queueListWidget, &QListWidget::itemClicked, this,
-                   [=]() { setQueueButtons(); });
-
-  QObject::connect(ui.queueListWidget, &QListWidget::currentItemChanged, this,
-                   [=]() { setQueueButtons(); });
-
-  QObject::connect(ui.queueListWidget, &QListWidget::itemSelectionChanged, this,
-                   [=]() { setQueueButtons(); });
-
-  QObject::connect(ListOfJobOptions::getInstance(),
-                   &ListOfJobOptions::tasksListUpdated, this,
-                   &MainWindow::listTasks);
-
-  mUploadIcon = arrowUpIcon;
-  mDownloadIcon = arrowDownIcon;
-  mMountIcon = mount1Icon;
-
-  // remove close button from these tabs
-  ui.tabs->tabBar()->setTabButton(0, QTabBar::RightSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(0, QTabBar::LeftSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(1, QTabBar::RightSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(1, QTabBar::LeftSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(2, QTabBar::RightSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(2, QTabBar::LeftSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(3, QTabBar::RightSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(3, QTabBar::LeftSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(4, QTabBar::RightSide, nullptr);
-  ui.tabs->tabBar()->setTabButton(4, QTabBar::LeftSide, nullptr);
-
-  ui.tabs->setCurrentIndex(0);
-
-  {
-    restoreSchedulersFromFile();
-    listTasks();
-    addTasksToQueue();
-  }
-
-  if (!(settings->value("Settings/schedulerStatus").toBool())) {
-
-    int schedulersCount = ui.schedulers->count();
-    for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-      QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-      if (auto scheduler = qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-
-        scheduler->stopScheduler();
-      }
-    }
-
-    ui.buttonStartScheduler->setEnabled(true);
-    ui.buttonStopScheduler->setEnabled(false);
-
-    ui.labelSchedulerInfoStart->hide();
-    ui.labelSchedulerInfoStop->show();
-
-    ui.tabs->setTabText(4, QString("Scheduler (%1)").arg(mSchedulersCount));
-  }
-
-  if ((settings->value("Settings/queueStatus").toBool())) {
-    ui.actionStartQueue->trigger();
-  }
+  // tasks are shown right away, queue and schedulers are restored once
+  // window is up
+  listTasks();
+  traceStartup("tasks listed");
+  QTimer::singleShot(0, this, SLOT(restoreSession()));
 
   QObject::connect(&mSystemTray, &QSystemTrayIcon::activated, this,
                    [=](QSystemTrayIcon::ActivationReason reason) {
@@ -2076,6 +1807,7 @@ MainWindow::MainWindow() {
                      if (canClose()) {
                        saveQueueFile();
                        saveSchedulerFile();
+                       flushConfigFiles();
                        QApplication::quit();
                      }
                    });
@@ -2088,22 +1820,47 @@ MainWindow::MainWindow() {
 
   QTimer::singleShot(0, ui.remotes, SLOT(setFocus()));
 
+  // remotes known from last run are shown until rclone answers, if rclone
+  // and its config did not change since then there is nothing to ask
+  bool remotesFresh = false;
+  QByteArray cachedRemotes = ReadRcloneCache("remotes", &remotesFresh);
+  if (!cachedRemotes.isEmpty()) {
+    showRemotes(QString::fromUtf8(cachedRemotes));
+    traceStartup("cached remotes shown");
+  }
+  // encrypted config password is asked for when remotes are listed
+  if (remotesFresh && IsRcloneConfEncrypted()) {
+    remotesFresh = false;
+  }
+
   QString rclone = GetRclone();
   if (rclone.isEmpty()) {
     rclone = QStandardPaths::findExecutable("rclone");
-    if (rclone.isEmpty()) {
-      QMessageBox::information(
-          this, "Error",
-          "Cannot check rclone version!\nPlease verify rclone location.");
-      emit ui.preferences->trigger();
-    } else {
+    if (!rclone.isEmpty()) {
       auto settings = GetSettings();
       settings->setValue("Settings/rclone", rclone);
       SetRclone(rclone);
-      rcloneGetVersion();
     }
+  }
+
+  if (rclone.isEmpty()) {
+    writeStartupTrace();
+    QMessageBox::information(
+        this, "Error",
+        "Cannot check rclone version!\nPlease verify rclone location.");
+    emit ui.preferences->trigger();
   } else {
-    rcloneGetVersion();
+    // version check and remotes listing run in parallel
+    mListRemotesAfterVersion = false;
+    if (remotesFresh) {
+      mStartupChecksPending = 1;
+      rcloneGetVersion();
+    } else {
+      mStartupChecksPending = 2;
+      rcloneGetVersion();
+      rcloneListRemotes();
+    }
+    traceStartup("rclone checks started");
   }
 
   // we start all auto mount tasks with 1s delay - so RB has chance to start
@@ -2121,6 +1878,9 @@ MainWindow::MainWindow() {
 }
 
 MainWindow::~MainWindow() {
+  // content comes from widgets which are gone when writers are deleted
+  flushConfigFiles();
+
   auto settings = GetSettings();
   settings->setValue("MainWindow/geometry", saveGeometry());
 }
@@ -2169,6 +1929,74 @@ MainWindow::sortListWidget(const QList<QListWidgetItem *> &list,
   return sortedList;
 }
 
+void MainWindow::restoreSession(void) {
+
+  auto settings = GetSettings();
+
+  restoreSchedulersFromFile();
+  addTasksToQueue();
+
+  if (!(settings->value("Settings/schedulerStatus").toBool())) {
+
+    int schedulersCount = ui.schedulers->count();
+    for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
+      QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
+      if (auto scheduler = qobject_cast<SchedulerWidget *>(schedulerWidget)) {
+
+        scheduler->stopScheduler();
+      }
+    }
+
+    ui.buttonStartScheduler->setEnabled(true);
+    ui.buttonStopScheduler->setEnabled(false);
+
+    ui.labelSchedulerInfoStart->hide();
+    ui.labelSchedulerInfoStop->show();
+
+    ui.tabs->setTabText(4, QString("Scheduler (%1)").arg(mSchedulersCount));
+  }
+
+  if ((settings->value("Settings/queueStatus").toBool())) {
+    ui.actionStartQueue->trigger();
+  }
+
+  traceStartup("queue and schedulers restored");
+}
+
+void MainWindow::traceStartup(const QString &phase) {
+  // trace is already written
+  if (!mStartupTimer.isValid()) {
+    return;
+  }
+  mStartupTrace << QString("%1 ms  %2")
+                       .arg(mStartupTimer.elapsed(), 6)
+                       .arg(phase);
+}
+
+void MainWindow::startupCheckFinished(const QString &phase) {
+  if (mStartupChecksPending == 0) {
+    return;
+  }
+  traceStartup(phase);
+  if (--mStartupChecksPending == 0) {
+    writeStartupTrace();
+  }
+}
+
+void MainWindow::writeStartupTrace(void) {
+  if (!mStartupTimer.isValid()) {
+    return;
+  }
+  mStartupTimer.invalidate();
+
+  QFile file(GetConfigDir().absoluteFilePath("startup.log"));
+  if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    file.write(mStartupTrace.join("\n").toUtf8() + "\n");
+    file.close();
+  }
+  mStartupTrace.clear();
+}
+
 void MainWindow::autoStartMounts(void) {
 
   // autostart all auto mounts from tasks list
@@ -2258,6 +2086,7 @@ void MainWindow::quitApp(void) {
     // no running widget - bye bye - quitting at last
     saveQueueFile();
     saveSchedulerFile();
+    flushConfigFiles();
     QApplication::quit();
   } else {
     // something still running we check again a bit later then
@@ -2395,14 +2224,14 @@ void MainWindow::setQueueButtons() {
 
     if (mQueueStatus) {
 
-      if (ui.queueListWidget->count() > 1) {
+      if (ui.queueListWidget->count() > mQueueRunningCount) {
         ui.buttonPurgeQueue->setEnabled(true);
       } else {
         ui.buttonPurgeQueue->setEnabled(false);
       }
 
-      if (ui.queueListWidget->count() > 0) {
-        ui.queueListWidget->item(0)->setSelected(false);
+      for (int i = 0; i < mQueueRunningCount; i++) {
+        ui.queueListWidget->item(i)->setSelected(false);
       }
 
     } else {
@@ -2418,14 +2247,17 @@ void MainWindow::setQueueButtons() {
 
   if (mQueueStatus) {
 
-    if (ui.queueListWidget->count() > 1) {
+    if (ui.queueListWidget->count() > mQueueRunningCount) {
       ui.buttonPurgeQueue->setEnabled(true);
     } else {
       ui.buttonPurgeQueue->setEnabled(false);
     }
 
-    if (ui.queueListWidget->currentRow() == 0 ||
-        ui.queueListWidget->currentRow() == ui.queueListWidget->count() - 1) {
+    // running tasks are at the top of the queue and can't be moved
+    int currentRow = ui.queueListWidget->currentRow();
+
+    if (currentRow < mQueueRunningCount ||
+        currentRow == ui.queueListWidget->count() - 1) {
       ui.buttonDownQueue->setEnabled(false);
       ui.actionDownQueue->setEnabled(false);
     } else {
@@ -2433,8 +2265,7 @@ void MainWindow::setQueueButtons() {
       ui.actionDownQueue->setEnabled(true);
     }
 
-    if (ui.queueListWidget->currentRow() == 1 ||
-        ui.queueListWidget->currentRow() == 0) {
+    if (currentRow <= mQueueRunningCount || currentRow == 0) {
       ui.buttonUpQueue->setEnabled(false);
       ui.actionUpQueue->setEnabled(false);
     } else {
@@ -2442,7 +2273,7 @@ void MainWindow::setQueueButtons() {
       ui.actionUpQueue->setEnabled(true);
     }
 
-    if (ui.queueListWidget->currentRow() == 0) {
+    if (currentRow < mQueueRunningCount) {
       ui.buttonRemoveFromQueue->setEnabled(false);
       ui.actionRemoveFromQueue->setEnabled(false);
     } else {
@@ -2450,8 +2281,8 @@ void MainWindow::setQueueButtons() {
       ui.actionRemoveFromQueue->setEnabled(true);
     }
 
-    if (ui.queueListWidget->count() > 0) {
-      ui.queueListWidget->item(0)->setSelected(false);
+    for (int i = 0; i < mQueueRunningCount; i++) {
+      ui.queueListWidget->item(i)->setSelected(false);
     }
 
   } else {
@@ -2489,323 +2320,703 @@ void MainWindow::setQueueButtons() {
   }
 }
 
-void MainWindow::rcloneGetVersion() {
-  bool firstTime = mFirstTime;
-  mFirstTime = false;
+// queue executor - start queued tasks while there are free slots
+// running tasks are moved to the top of the queue
+void MainWindow::runQueue() {
 
-  QProcess *p = new QProcess();
+  orderQueue();
 
-  QObject::connect(
-      p,
-      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
-          &QProcess::finished),
-      this, [=](int code, QProcess::ExitStatus) {
-        if (code == 0) {
-          QString version = p->readAllStandardOutput().trimmed();
-
-          // extract rclone version - numbers only
-          QString rclone_info1 = version;
-          QString rclone_version_no;
-          int lineBreak = rclone_info1.indexOf('\n');
-          if (lineBreak != -1) {
-            rclone_info1.remove(lineBreak, rclone_info1.length() - lineBreak);
-            rclone_version_no = rclone_info1;
-            rclone_version_no.replace("rclone v", "");
-            rclone_version_no.replace("-DEV", "");
-          } else {
-            // for very old rclone versions format was one line only
-            rclone_version_no = rclone_info1.trimmed();
-            rclone_version_no.replace("rclone v", "");
-            rclone_version_no.replace("-DEV", "");
-          }
-          // save current version no in settings
-          auto settings = GetSettings();
-          settings->setValue("Settings/rcloneVersion", rclone_version_no);
+  if (!mQueueStatus || mAppQuittingStatus) {
+    updateQueueTabText();
+    return;
+  }
 
-#if defined(Q_OS_WIN32)
-          // check if required version
-          unsigned int result =
-              compareVersion(rclone_version_no.toStdString(), "1.50");
+  auto settings = GetSettings();
+  // transfers started outside of the queue occupy slots as well
+  int slots = qMax(1, settings->value("Settings/queueSlots", 1).toInt());
+  int remoteCap = settings->value("Settings/queueRemoteCap", 0).toInt();
 
-          if (result == 2) {
-            QMessageBox::warning(
-                this, "",
-                "For mount functionality to work you need "
-                "rclone version at least v1.50 "
-                "and your current version is v" +
-                    rclone_version_no +
-                    ". Mount will be disabled. \n\nPlease consider upgrading.");
-          };
-#endif
+  QSet<QString> queuedRequests;
+  QHash<QString, int> remotesUsage;
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 1)
-          QStringList lines = version.split("\n", Qt::SkipEmptyParts);
-#else
-          QStringList lines = version.split("\n", QString::SkipEmptyParts);
-#endif
+  for (int i = 0; i < ui.queueListWidget->count(); i++) {
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    queuedRequests.insert(item->GetRequestId());
 
-          QString rclone_info2;
-          QString rclone_info3;
-
-          int counter = 0;
-          foreach (QString line, lines) {
-            line = line.trimmed();
-            if (counter == 1)
-              rclone_info2 = line.replace("- ", "");
-            if (counter == 2)
-              rclone_info3 = line.replace("- ", "");
-            counter++;
-          };
+    if (i < mQueueRunningCount) {
+      for (const QString &remote : GetTaskRemotes(item->GetData())) {
+        remotesUsage[remote]++;
+      }
+    }
+  }
 
-          QFileInfo appBundlePath;
-#ifdef Q_OS_MACOS
-          if (IsPortableMode()) {
+  for (int i = mQueueRunningCount;
+       i < ui.queueListWidget->count() && mTransferJobCount < slots; i++) {
 
-            QFileInfo applicationPath = qApp->applicationFilePath();
-            QFileInfo MacOSPath = applicationPath.dir().path();
-            QFileInfo ContentsPath = MacOSPath.dir().path();
-            appBundlePath = ContentsPath.dir().path();
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    JobOptions *jo = item->GetData();
 
-            mStatusMessage->setText(rclone_info1 + ", " + rclone_info2 + ", " +
-                                    rclone_info3);
+    // wait until task it depends on leaves the queue
+    if (!item->GetDependsOn().isEmpty() &&
+        queuedRequests.contains(item->GetDependsOn())) {
+      continue;
+    }
 
-            mStatusMessage->setToolTip(
-                rclone_info1 + " in " +
-                QDir::toNativeSeparators(GetRclone().replace(
-                    appBundlePath.fileName() + "/Contents/MacOS/../../../",
-                    "")) +
-                ", " + rclone_info2 + ", " + rclone_info3);
+    QStringList remotes = GetTaskRemotes(jo);
+    if (IsRemoteBusy(remotes, remotesUsage, remoteCap)) {
+      continue;
+    }
 
-          } else {
+    // the same task could be started by user manually
+    bool isAlreadyRunning = false;
+    int widgetsCount = ui.jobs->count();
+    for (int j = widgetsCount - 2; j >= 0; j = j - 2) {
+      QWidget *widget = ui.jobs->itemAt(j)->widget();
+      if (auto transfer = qobject_cast<JobWidget *>(widget)) {
+        if ((transfer->getUniqueID() == jo->uniqueId.toString()) &&
+            (transfer->isRunning)) {
+          isAlreadyRunning = true;
+          break;
+        }
+      }
+    }
+    if (isAlreadyRunning) {
+      continue;
+    }
 
-            mStatusMessage->setText(rclone_info1 + ", " + rclone_info2 + ", " +
-                                    rclone_info3);
+    ui.queueListWidget->takeItem(i);
+    ui.queueListWidget->insertItem(mQueueRunningCount, item);
+    item->setBackground(Qt::darkGreen);
+    item->setSelected(false);
+    ++mQueueRunningCount;
 
-            mStatusMessage->setToolTip(
-                rclone_info1 + " in " + QDir::toNativeSeparators(GetRclone()) +
-                ", " + rclone_info2 + ", " + rclone_info3);
-          }
-#else
-#ifdef Q_OS_WIN
-          mStatusMessage->setText(rclone_info1 + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+    for (const QString &remote : remotes) {
+      remotesUsage[remote]++;
+    }
 
+    runItem(item, "queue", item->GetRequestId());
+  }
 
-          mStatusMessage->setToolTip(rclone_info1 + " in " +
-                                  QDir::toNativeSeparators(GetRclone()) + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+  updateQueueTabText();
+  setQueueButtons();
+}
 
-#else
-          if (IsPortableMode()) {
-            QString xdg_config_home = qgetenv("XDG_CONFIG_HOME");
-            QString appImageConfigFolder = xdg_config_home.right(xdg_config_home.length()-xdg_config_home.lastIndexOf("/"));
+// row behind running and other priority tasks
+int MainWindow::getQueuePriorityRow() {
 
-            mStatusMessage->setText(rclone_info1 + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+  QList<bool> ahead;
+  for (int i = 0; i < ui.queueListWidget->count(); i++) {
+    ahead << (i < mQueueRunningCount ||
+              static_cast<JobOptionsListWidgetItem *>(
+                  ui.queueListWidget->item(i))
+                  ->GetPriority());
+  }
+  return GetQueuePriorityRow(ahead);
+}
 
-            mStatusMessage->setToolTip(rclone_info1 + " in " +
-                                  QDir::toNativeSeparators(GetRclone().replace(appImageConfigFolder + "/..",  "")) + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+// true if any of remotes is used by at least cap running transfers,
+// transfers started outside of the queue are counted as well
+bool MainWindow::isRemoteBusy(const QStringList &remotes, int cap) {
 
+  if (cap <= 0 || remotes.isEmpty()) {
+    return false;
+  }
 
-          } else {
-            mStatusMessage->setText(rclone_info1 + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+  QHash<QString, int> remotesUsage;
+  int widgetsCount = ui.jobs->count();
+  for (int j = widgetsCount - 2; j >= 0; j = j - 2) {
+    QWidget *widget = ui.jobs->itemAt(j)->widget();
+    if (auto transfer = qobject_cast<JobWidget *>(widget)) {
+      if (transfer->isRunning) {
+        QStringList paths = QStringList()
+                            << transfer->getSource() << transfer->getDest();
+        for (const QString &remote : GetPathRemotes(paths)) {
+          remotesUsage[remote]++;
+        }
+      }
+    }
+  }
 
-            mStatusMessage->setToolTip(rclone_info1 + " in " +
-                                  QDir::toNativeSeparators(GetRclone()) + ", " +
-                                  rclone_info2 + ", " + rclone_info3);
+  return IsRemoteBusy(remotes, remotesUsage, cap);
+}
 
+// Queue (waiting tasks)>>(running tasks/slots)
+void MainWindow::updateQueueTabText() {
 
-         }
-#endif
-#endif
+  if (mQueueStatus) {
+    auto settings = GetSettings();
+    int slots = qMax(1, settings->value("Settings/queueSlots", 1).toInt());
+
+    ui.tabs->setTabText(3, QString("Queue (%1)>>(%2/%3)")
+                               .arg(mQueueCount - mQueueRunningCount)
+                               .arg(mQueueRunningCount)
+                               .arg(slots));
+    ui.tabs->setTabToolTip(
+        3, QString("%1 of %2 transfer slots in use").arg(mTransferJobCount).arg(
+               slots));
+  } else {
+    if (mQueueCount == 0) {
+      ui.tabs->setTabText(3, QString("Queue"));
+    } else {
+      ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
+    }
+    ui.tabs->setTabToolTip(3, QString());
+  }
 
-          rcloneListRemotes();
-        } else {
-          if (p->error() != QProcess::FailedToStart) {
-            if (getConfigPassword(p)) {
-              rcloneGetVersion();
-            } else {
-              close();
-            }
-            p->deleteLater();
-            return;
-          }
+  updateQueueEta();
+}
 
-          if (firstTime) {
-            if (p->error() == QProcess::FailedToStart) {
-              QMessageBox::information(
-                  this, "Error",
-                  "Wrong rclone executable or rclone not found!\nPlease select "
-                  "its location in next dialog.");
-            } else {
-              QMessageBox::information(this, "Error",
-                                       "Cannot check rclone version!\nPlease "
-                                       "verify rclone location.");
-            }
-            emit ui.preferences->trigger();
-          }
+void MainWindow::setQueueDependency(JobOptionsListWidgetItem *item,
+                                    const QString &requestId) {
+
+  item->SetDependsOn(requestId);
+
+  QString dependsOnName;
+  for (int i = 0; i < ui.queueListWidget->count() && !requestId.isEmpty();
+       i++) {
+    JobOptionsListWidgetItem *item_queue =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    if (item_queue->GetRequestId() == requestId) {
+      dependsOnName = item_queue->GetData()->description;
+      break;
+    }
+  }
+
+  QFont font = item->font();
+  font.setItalic(!requestId.isEmpty());
+  item->setFont(font);
+
+  if (requestId.isEmpty()) {
+    item->setToolTip(QString());
+  } else {
+    item->setToolTip("Runs after: " + dependsOnName);
+  }
+}
+
+// estimated seconds left for running queue tasks, 0 when not known
+QList<qint64>
+MainWindow::getQueueRunningRemaining(const QHash<QString, qint64> &estimates) {
+
+  QList<qint64> remaining;
+  QDateTime now = QDateTime::currentDateTime();
+
+  for (int i = 0; i < mQueueRunningCount; i++) {
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    QString taskId = item->GetData()->uniqueId.toString();
+
+    qint64 elapsed = 0;
+    int widgetsCount = ui.jobs->count();
+    for (int j = widgetsCount - 2; j >= 0; j = j - 2) {
+      QWidget *widget = ui.jobs->itemAt(j)->widget();
+      if (auto transfer = qobject_cast<JobWidget *>(widget)) {
+        if ((transfer->getUniqueID() == taskId) && (transfer->isRunning) &&
+            (transfer->getRequestId() == item->GetRequestId())) {
+          elapsed = transfer->getStartDateTime().secsTo(now);
+          break;
         }
+      }
+    }
 
-        auto settings = GetSettings();
+    remaining << qMax<qint64>(0, estimates.value(taskId, 0) - elapsed);
+  }
+  return remaining;
+}
 
-        /// check rclone version
+// reorder waiting tasks, the same rules as headless instance uses
+void MainWindow::orderQueue() {
 
-        // get already stored rclone version no
-        QString rclone_version_no =
-            settings->value("Settings/rcloneVersion").toString();
+  if (ui.queueListWidget->count() - mQueueRunningCount < 2) {
+    return;
+  }
 
-        // during first run the key might not exist yet
-        if (!(settings->contains("Settings/checkRcloneUpdates"))) {
-          // if checkRcloneUpdates does not exist create new key
-          settings->setValue("Settings/checkRcloneUpdates", true);
-        };
+  QList<JobOptionsListWidgetItem *> waiting;
+  QList<QueuedTask> tasks;
+  for (int i = mQueueRunningCount; i < ui.queueListWidget->count(); i++) {
+    auto item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    QueuedTask task;
+    task.taskId = item->GetData()->uniqueId.toString();
+    task.priority = item->GetPriority();
+    waiting << item;
+    tasks << task;
+  }
 
-        bool checkRcloneUpdates =
-            settings->value("Settings/checkRcloneUpdates").toBool();
+  QList<int> order = GetQueueOrder(
+      tasks, getQueueRunningRemaining(
+                 JobHistory::getInstance()->getEstimatedDurations()));
 
-        // if check updates enabled in settings
-        if (checkRcloneUpdates) {
-          QString last_check;
-          QString current_date = QDate::currentDate().toString();
+  QList<JobOptionsListWidgetItem *> ordered;
+  for (int i : order) {
+    ordered << waiting.at(i);
+  }
 
-          if (!(settings->contains("Settings/lastRcloneUpdateCheck"))) {
-            // if lastRcloneUpdateCheck does not exist create new key
-            settings->setValue("Settings/lastRcloneUpdateCheck", current_date);
-          } else { // read last check date
-            last_check =
-                settings->value("Settings/lastRcloneUpdateCheck").toString();
-          };
+  if (ordered == waiting) {
+    return;
+  }
 
-          // dont check if already checked today (once per day only)
-          if (!(last_check == current_date)) {
-            // remmber when last checked
-            settings->setValue("Settings/lastRcloneUpdateCheck", current_date);
-
-            QString url =
-                "https://api.github.com/repos/rclone/rclone/releases/latest";
-            QNetworkAccessManager manager;
-            QNetworkReply *response = manager.get(QNetworkRequest(QUrl(url)));
-            QEventLoop event;
-            connect(response, SIGNAL(finished()), &event, SLOT(quit()));
-            event.exec();
-            QByteArray content = response->readAll();
-            QJsonParseError jsonError;
-
-            QJsonDocument document = QJsonDocument::fromJson(
-                content, &jsonError); // parse and capture the error flag
-
-            if (jsonError.error == QJsonParseError::NoError) {
-
-              if (document.object().contains("tag_name")) {
-
-                QJsonValue tag_name = document.object().value("tag_name");
-
-                QString rclone_latest_version_no = tag_name.toString(QString());
-
-                rclone_latest_version_no.replace("v", "");
-                rclone_latest_version_no.replace("-DEV", "");
-                rclone_latest_version_no = rclone_latest_version_no.trimmed();
-
-                // check if new version available and if yes display information
-                unsigned int result =
-                    compareVersion(rclone_latest_version_no.toStdString(),
-                                   rclone_version_no.toStdString());
-                // latest version is greater than current
-                if (result == 1) {
-
-                  QMessageBox::information(
-                      this, "",
-                      QString(
-                          R"(<p>New rclone version is available</p>)"
-                          R"(<p>You have: v)" +
-                          rclone_version_no +
-                          "<br />"
-                          R"(New version: v)" +
-                          rclone_latest_version_no +
-                          "</p>"
-                          R"(<p>Visit rclone <a href="https://rclone.org/downloads/">downloads</a> page to upgrade</p>)"));
-                };
-              };
-            };
-          };
-        };
+  QListWidgetItem *currentItem = ui.queueListWidget->currentItem();
+
+  for (int i = ui.queueListWidget->count() - 1; i >= mQueueRunningCount; i--) {
+    ui.queueListWidget->takeItem(i);
+  }
+  for (auto item : ordered) {
+    ui.queueListWidget->addItem(item);
+  }
+
+  if (currentItem != nullptr) {
+    ui.queueListWidget->setCurrentItem(currentItem);
+  }
 
-        /// check rclone browser version
+  saveQueueFile();
+}
 
-        // during first run the key might not exist yet
-        if (!(settings->contains("Settings/checkRcloneBrowserUpdates"))) {
-          // if checkRcloneBrowserUpdates does not exist create new key
-          settings->setValue("Settings/checkRcloneBrowserUpdates", true);
-        };
+// moving tasks by hand overrides automatic order
+void MainWindow::switchToManualQueueOrder() {
+  auto settings = GetSettings();
+  if (settings->value("Settings/queueOrder").toString() != "manual") {
+    settings->setValue("Settings/queueOrder", "manual");
+    ui.statusBar->showMessage("Queue order switched to manual", 5000);
+  }
+}
+
+// predicted finish of the whole queue
+void MainWindow::updateQueueEta() {
+
+  if (ui.queueListWidget->count() == 0) {
+    ui.labelQueueEta->clear();
+    ui.labelQueueEta->setToolTip(QString());
+    return;
+  }
+
+  auto settings = GetSettings();
+  int slots = qMax(1, settings->value("Settings/queueSlots", 1).toInt());
+
+  QHash<QString, qint64> estimates =
+      JobHistory::getInstance()->getEstimatedDurations();
+
+  QList<qint64> slotsFree = getQueueRunningRemaining(estimates);
+  while (slotsFree.count() < slots) {
+    slotsFree << 0;
+  }
 
-        bool checkRcloneBrowserUpdates =
-            settings->value("Settings/checkRcloneBrowserUpdates").toBool();
-
-        // if check updates enabled in settings
-        if (checkRcloneBrowserUpdates) {
-          QString last_check;
-          QString current_date = QDate::currentDate().toString();
-
-          if (!(settings->contains("Settings/lastRcloneBrowserUpdateCheck"))) {
-            // if lastRcloneBrowserUpdateCheck does not exist create new key
-            settings->setValue("Settings/lastRcloneBrowserUpdateCheck",
-                               current_date);
-          } else { // read last check date
-            last_check =
-                settings->value("Settings/lastRcloneBrowserUpdateCheck")
-                    .toString();
+  int unknown = 0;
+  for (int i = 0; i < ui.queueListWidget->count(); i++) {
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
+    qint64 duration =
+        estimates.value(item->GetData()->uniqueId.toString(), -1);
+
+    if (duration < 0) {
+      unknown++;
+    } else if (i >= mQueueRunningCount) {
+      slotsFree[GetEarliestSlot(slotsFree)] += duration;
+    }
+  }
+
+  if (unknown == ui.queueListWidget->count()) {
+    ui.labelQueueEta->setText("No history to estimate finish time.");
+    ui.labelQueueEta->setStyleSheet(QString());
+    ui.labelQueueEta->setToolTip(QString());
+    return;
+  }
+
+  qint64 finishSecs = 0;
+  for (qint64 slotFree : slotsFree) {
+    finishSecs = qMax(finishSecs, slotFree);
+  }
+
+  QString eta;
+  if (mQueueStatus) {
+    eta = "Estimated finish: " +
+          QLocale(QLocale::English)
+              .toString(QDateTime::currentDateTime().addSecs(finishSecs),
+                        "ddd HH:mm");
+  } else {
+    eta = QString("Estimated run time: %1h %2m")
+              .arg(finishSecs / 3600)
+              .arg((finishSecs % 3600) / 60, 2, 10, QChar('0'));
+  }
+
+  if (unknown > 0) {
+    eta += QString(" (+%1 without history)").arg(unknown);
+  }
+
+  ui.labelQueueEta->setText(eta);
+
+  if (settings->value("Settings/queueOrder").toString() == "window" &&
+      finishSecs > GetQueueWindowSecs()) {
+    ui.labelQueueEta->setStyleSheet("QLabel { color: red; }");
+    ui.labelQueueEta->setToolTip(
+        "Queue is not expected to finish before " +
+        settings->value("Settings/queueWindowEnd").toString());
+  } else {
+    ui.labelQueueEta->setStyleSheet(QString());
+    ui.labelQueueEta->setToolTip(QString());
+  }
+}
+
+void MainWindow::showRcloneVersion(const QString &version) {
+
+  // extract rclone version - numbers only
+  QString rclone_info1 = version;
+  QString rclone_version_no;
+  int lineBreak = rclone_info1.indexOf('\n');
+  if (lineBreak != -1) {
+    rclone_info1.remove(lineBreak, rclone_info1.length() - lineBreak);
+    rclone_version_no = rclone_info1;
+    rclone_version_no.replace("rclone v", "");
+    rclone_version_no.replace("-DEV", "");
+  } else {
+    // for very old rclone versions format was one line only
+    rclone_version_no = rclone_info1.trimmed();
+    rclone_version_no.replace("rclone v", "");
+    rclone_version_no.replace("-DEV", "");
+  }
+  // save current version no in settings
+  auto settings = GetSettings();
+  settings->setValue("Settings/rcloneVersion", rclone_version_no);
+
+#if defined(Q_OS_WIN32)
+  // check if required version
+  unsigned int result =
+      compareVersion(rclone_version_no.toStdString(), "1.50");
+
+  if (result == 2) {
+    QMessageBox::warning(
+        this, "",
+        "For mount functionality to work you need "
+        "rclone version at least v1.50 "
+        "and your current version is v" +
+            rclone_version_no +
+            ". Mount will be disabled. \n\nPlease consider upgrading.");
+  };
+#endif
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 1)
+  QStringList lines = version.split("\n", Qt::SkipEmptyParts);
+#else
+  QStringList lines = version.split("\n", QString::SkipEmptyParts);
+#endif
+
+  QString rclone_info2;
+  QString rclone_info3;
+
+  int counter = 0;
+  foreach (QString line, lines) {
+    line = line.trimmed();
+    if (counter == 1)
+      rclone_info2 = line.replace("- ", "");
+    if (counter == 2)
+      rclone_info3 = line.replace("- ", "");
+    counter++;
+  };
+
+  QFileInfo appBundlePath;
+#ifdef Q_OS_MACOS
+  if (IsPortableMode()) {
+
+    QFileInfo applicationPath = qApp->applicationFilePath();
+    QFileInfo MacOSPath = applicationPath.dir().path();
+    QFileInfo ContentsPath = MacOSPath.dir().path();
+    appBundlePath = ContentsPath.dir().path();
+
+    mStatusMessage->setText(rclone_info1 + ", " + rclone_info2 + ", " +
+                            rclone_info3);
+
+    mStatusMessage->setToolTip(
+        rclone_info1 + " in " +
+        QDir::toNativeSeparators(GetRclone().replace(
+            appBundlePath.fileName() + "/Contents/MacOS/../../../",
+            "")) +
+        ", " + rclone_info2 + ", " + rclone_info3);
+
+  } else {
+
+    mStatusMessage->setText(rclone_info1 + ", " + rclone_info2 + ", " +
+                            rclone_info3);
+
+    mStatusMessage->setToolTip(
+        rclone_info1 + " in " + QDir::toNativeSeparators(GetRclone()) +
+        ", " + rclone_info2 + ", " + rclone_info3);
+  }
+#else
+#ifdef Q_OS_WIN
+  mStatusMessage->setText(rclone_info1 + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+
+  mStatusMessage->setToolTip(rclone_info1 + " in " +
+                          QDir::toNativeSeparators(GetRclone()) + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+#else
+  if (IsPortableMode()) {
+    QString xdg_config_home = qgetenv("XDG_CONFIG_HOME");
+    QString appImageConfigFolder = xdg_config_home.right(xdg_config_home.length()-xdg_config_home.lastIndexOf("/"));
+
+    mStatusMessage->setText(rclone_info1 + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+    mStatusMessage->setToolTip(rclone_info1 + " in " +
+                          QDir::toNativeSeparators(GetRclone().replace(appImageConfigFolder + "/..",  "")) + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+
+  } else {
+    mStatusMessage->setText(rclone_info1 + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+    mStatusMessage->setToolTip(rclone_info1 + " in " +
+                          QDir::toNativeSeparators(GetRclone()) + ", " +
+                          rclone_info2 + ", " + rclone_info3);
+
+
+ }
+#endif
+#endif
+}
+
+void MainWindow::checkForUpdates() {
+
+  auto settings = GetSettings();
+
+  /// check rclone version
+
+  // get already stored rclone version no
+  QString rclone_version_no =
+      settings->value("Settings/rcloneVersion").toString();
+
+  // during first run the key might not exist yet
+  if (!(settings->contains("Settings/checkRcloneUpdates"))) {
+    // if checkRcloneUpdates does not exist create new key
+    settings->setValue("Settings/checkRcloneUpdates", true);
+  };
+
+  bool checkRcloneUpdates =
+      settings->value("Settings/checkRcloneUpdates").toBool();
+
+  // if check updates enabled in settings
+  if (checkRcloneUpdates) {
+    QString last_check;
+    QString current_date = QDate::currentDate().toString();
+
+    if (!(settings->contains("Settings/lastRcloneUpdateCheck"))) {
+      // if lastRcloneUpdateCheck does not exist create new key
+      settings->setValue("Settings/lastRcloneUpdateCheck", current_date);
+    } else { // read last check date
+      last_check =
+          settings->value("Settings/lastRcloneUpdateCheck").toString();
+    };
+
+    // dont check if already checked today (once per day only)
+    if (!(last_check == current_date)) {
+      // remmber when last checked
+      settings->setValue("Settings/lastRcloneUpdateCheck", current_date);
+
+      QString url =
+          "https://api.github.com/repos/rclone/rclone/releases/latest";
+      QNetworkAccessManager manager;
+      QNetworkReply *response = manager.get(QNetworkRequest(QUrl(url)));
+      QEventLoop event;
+      connect(response, SIGNAL(finished()), &event, SLOT(quit()));
+      event.exec();
+      QByteArray content = response->readAll();
+      QJsonParseError jsonError;
+
+      QJsonDocument document = QJsonDocument::fromJson(
+          content, &jsonError); // parse and capture the error flag
+
+      if (jsonError.error == QJsonParseError::NoError) {
+
+        if (document.object().contains("tag_name")) {
+
+          QJsonValue tag_name = document.object().value("tag_name");
+
+          QString rclone_latest_version_no = tag_name.toString(QString());
+
+          rclone_latest_version_no.replace("v", "");
+          rclone_latest_version_no.replace("-DEV", "");
+          rclone_latest_version_no = rclone_latest_version_no.trimmed();
+
+          // check if new version available and if yes display information
+          unsigned int result =
+              compareVersion(rclone_latest_version_no.toStdString(),
+                             rclone_version_no.toStdString());
+          // latest version is greater than current
+          if (result == 1) {
+
+            QMessageBox::information(
+                this, "",
+                QString(
+                    R"(<p>New rclone version is available</p>)"
+                    R"(<p>You have: v)" +
+                    rclone_version_no +
+                    "<br />"
+                    R"(New version: v)" +
+                    rclone_latest_version_no +
+                    "</p>"
+                    R"(<p>Visit rclone <a href="https://rclone.org/downloads/">downloads</a> page to upgrade</p>)"));
           };
+        };
+      };
+    };
+  };
+
+  /// check rclone browser version
 
-          // dont check if already checked today (once per day only)
-          if (!(last_check == current_date)) {
-            // remmber when last checked
-            settings->setValue("Settings/lastRcloneBrowserUpdateCheck",
-                               current_date);
-
-            // get latest version available
-            QString url = "https://api.github.com/repos/kapitainsky/"
-                          "rclonebrowser/releases/latest";
-            QNetworkAccessManager manager;
-            QNetworkReply *response = manager.get(QNetworkRequest(QUrl(url)));
-            QEventLoop event;
-            connect(response, SIGNAL(finished()), &event, SLOT(quit()));
-            event.exec();
-            QByteArray content = response->readAll();
-
-            QJsonParseError jsonError;
-            QJsonDocument document = QJsonDocument::fromJson(
-                content, &jsonError); // parse and capture the error flag
-
-            if (jsonError.error == QJsonParseError::NoError) {
-              if (document.object().contains("tag_name")) {
-                QJsonValue tag_name = document.object().value("tag_name");
-                QString rclone_browser_latest_version_no =
-                    tag_name.toString(QString());
-                rclone_browser_latest_version_no =
-                    rclone_browser_latest_version_no.trimmed();
-
-                // check if new version available and if yes display information
-                unsigned int result = compareVersion(
-                    rclone_browser_latest_version_no.toStdString(),
-                    RCLONE_BROWSER_VERSION);
-                // latest version is greater than current
-                if (result == 1) {
-                  QMessageBox::information(
-                      this, "",
-                      QString(
-                          R"(<p>New Rclone Browser version is available</p>)"
-                          R"(<p>You have: v)" RCLONE_BROWSER_VERSION "<br />"
-                          R"(New version: v)" +
-                          rclone_browser_latest_version_no +
-                          "</p>"
-                          R"(<p>Visit <a href="https://github.com/kapitainsky/RcloneBrowser/releases/latest">releases</a> page to download</p>)"));
-                };
-              };
-            };
+  // during first run the key might not exist yet
+  if (!(settings->contains("Settings/checkRcloneBrowserUpdates"))) {
+    // if checkRcloneBrowserUpdates does not exist create new key
+    settings->setValue("Settings/checkRcloneBrowserUpdates", true);
+  };
+
+  bool checkRcloneBrowserUpdates =
+      settings->value("Settings/checkRcloneBrowserUpdates").toBool();
+
+  // if check updates enabled in settings
+  if (checkRcloneBrowserUpdates) {
+    QString last_check;
+    QString current_date = QDate::currentDate().toString();
+
+    if (!(settings->contains("Settings/lastRcloneBrowserUpdateCheck"))) {
+      // if lastRcloneBrowserUpdateCheck does not exist create new key
+      settings->setValue("Settings/lastRcloneBrowserUpdateCheck",
+                         current_date);
+    } else { // read last check date
+      last_check =
+          settings->value("Settings/lastRcloneBrowserUpdateCheck")
+              .toString();
+    };
+
+    // dont check if already checked today (once per day only)
+    if (!(last_check == current_date)) {
+      // remmber when last checked
+      settings->setValue("Settings/lastRcloneBrowserUpdateCheck",
+                         current_date);
+
+      // get latest version available
+      QString url = "https://api.github.com/repos/kapitainsky/"
+                    "rclonebrowser/releases/latest";
+      QNetworkAccessManager manager;
+      QNetworkReply *response = manager.get(QNetworkRequest(QUrl(url)));
+      QEventLoop event;
+      connect(response, SIGNAL(finished()), &event, SLOT(quit()));
+      event.exec();
+      QByteArray content = response->readAll();
+
+      QJsonParseError jsonError;
+      QJsonDocument document = QJsonDocument::fromJson(
+          content, &jsonError); // parse and capture the error flag
+
+      if (jsonError.error == QJsonParseError::NoError) {
+        if (document.object().contains("tag_name")) {
+          QJsonValue tag_name = document.object().value("tag_name");
+          QString rclone_browser_latest_version_no =
+              tag_name.toString(QString());
+          rclone_browser_latest_version_no =
+              rclone_browser_latest_version_no.trimmed();
+
+          // check if new version available and if yes display information
+          unsigned int result = compareVersion(
+              rclone_browser_latest_version_no.toStdString(),
+              RCLONE_BROWSER_VERSION);
+          // latest version is greater than current
+          if (result == 1) {
+            QMessageBox::information(
+                this, "",
+                QString(
+                    R"(<p>New Rclone Browser version is available</p>)"
+                    R"(<p>You have: v)" RCLONE_BROWSER_VERSION "<br />"
+                    R"(New version: v)" +
+                    rclone_browser_latest_version_no +
+                    "</p>"
+                    R"(<p>Visit <a href="https://github.com/kapitainsky/RcloneBrowser/releases/latest">releases</a> page to download</p>)"));
           };
         };
+      };
+    };
+  };
+}
+
+void MainWindow::rcloneGetVersion() {
+  bool firstTime = mFirstTime;
+  mFirstTime = false;
+
+  // rclone binary and its config did not change since last check
+  bool fresh = false;
+  QByteArray cachedVersion = ReadRcloneCache("version", &fresh);
+  if (fresh && !cachedVersion.isEmpty()) {
+    QTimer::singleShot(0, this, [=]() {
+      showRcloneVersion(QString::fromUtf8(cachedVersion).trimmed());
+      startupCheckFinished("rclone version read from cache");
+
+      if (mListRemotesAfterVersion) {
+        rcloneListRemotes();
+      }
+      mListRemotesAfterVersion = true;
+
+      checkForUpdates();
+    });
+    return;
+  }
+
+  mVersionCheckRunning = true;
+
+  QProcess *p = new QProcess();
+
+  QObject::connect(
+      p,
+      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+          &QProcess::finished),
+      this, [=](int code, QProcess::ExitStatus) {
+        if (code == 0) {
+          mVersionCheckRunning = false;
+          startupCheckFinished("rclone version checked");
+
+          QByteArray version = p->readAllStandardOutput();
+          WriteRcloneCache("version", version);
+          showRcloneVersion(QString::fromUtf8(version).trimmed());
+
+          // unless remotes are being listed already in parallel
+          if (mListRemotesAfterVersion) {
+            rcloneListRemotes();
+          }
+          mListRemotesAfterVersion = true;
+        } else {
+          if (p->error() != QProcess::FailedToStart) {
+            if (getConfigPassword(p)) {
+              // remotes listing needs password as well
+              mListRemotesAfterVersion = true;
+              rcloneGetVersion();
+            } else {
+              mVersionCheckRunning = false;
+              close();
+            }
+            p->deleteLater();
+            return;
+          }
+          mVersionCheckRunning = false;
+          startupCheckFinished("rclone version check failed");
+
+          if (firstTime) {
+            if (p->error() == QProcess::FailedToStart) {
+              QMessageBox::information(
+                  this, "Error",
+                  "Wrong rclone executable or rclone not found!\nPlease select "
+                  "its location in next dialog.");
+            } else {
+              QMessageBox::information(this, "Error",
+                                       "Cannot check rclone version!\nPlease "
+                                       "verify rclone location.");
+            }
+            emit ui.preferences->trigger();
+          }
+        }
+
+        checkForUpdates();
 
         p->deleteLater();
       });
@@ -2819,6 +3030,8 @@ void MainWindow::rcloneGetVersion() {
             this, "Error",
             "Cannot start rclone\n\n Error: " + errorString +
                 "\n\nPlease verify rclone excecutable location.");
+        mVersionCheckRunning = false;
+        startupCheckFinished("rclone failed to start");
         emit ui.preferences->trigger();
       });
 
@@ -2919,187 +3132,199 @@ void MainWindow::rcloneConfig() {
 #endif
 }
 
-void MainWindow::rcloneListRemotes() {
+void MainWindow::showRemotes(const QString &remotes) {
 
   ui.remotes->clear();
 
-  auto settings = GetSettings();
-  QString mIconsLayout = settings->value("Settings/iconsLayout").toString();
+  QStyle *style = qApp->style();
 
-  QProcess *p = new QProcess();
+  QStringList items = remotes.trimmed().split('\n');
 
-  QObject::connect(
-      p,
-      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
-          &QProcess::finished),
-      this, [=](int code, QProcess::ExitStatus) {
-        if (code == 0) {
-          QStyle *style = qApp->style();
-
-          QString bytes = p->readAllStandardOutput().trimmed();
-          QStringList items = bytes.split('\n');
+  auto settings = GetSettings();
+  QString mIconsLayout = settings->value("Settings/iconsLayout").toString();
+  bool darkModeIni = settings->value("Settings/darkModeIni").toBool();
+  QString iconSize = settings->value("Settings/iconSize").toString();
+  QString iconsColour = settings->value("Settings/iconsColour").toString();
 
-          auto settings = GetSettings();
-          bool darkModeIni = settings->value("Settings/darkModeIni").toBool();
-          QString iconSize = settings->value("Settings/iconSize").toString();
-          QString iconsColour =
-              settings->value("Settings/iconsColour").toString();
-
-          for (const QString &line : items) {
-            if (line.isEmpty()) {
-              continue;
-            }
+  for (const QString &line : items) {
+    if (line.isEmpty()) {
+      continue;
+    }
 
-            QStringList parts = line.split(':');
-            if (parts.count() != 2) {
-              continue;
-            }
+    QStringList parts = line.split(':');
+    if (parts.count() != 2) {
+      continue;
+    }
 
-            QString name = parts[0].trimmed();
-            QString type = parts[1].trimmed();
-            QString tooltip = "type: " + type + "\n\nname: " + name;
+    QString name = parts[0].trimmed();
+    QString type = parts[1].trimmed();
+    QString tooltip = "type: " + type + "\n\nname: " + name;
 
-            QString img_add = "";
-            int size;
+    QString img_add = "";
+    int size;
 
-            // medium scale by default
-            double darkModeIconScale = 1.333;
-            double lightModeiconScale = 2;
-            // to avoid "variable not used" compiler error
-            if (darkModeIconScale == lightModeiconScale) {
-            };
+    // medium scale by default
+    double darkModeIconScale = 1.333;
+    double lightModeiconScale = 2;
+    // to avoid "variable not used" compiler error
+    if (darkModeIconScale == lightModeiconScale) {
+    };
 
-            // set icons scale based on iconSize value
-            if (iconSize == "S") {
-              lightModeiconScale = 3;
-              darkModeIconScale = 2;
-            }
+    // set icons scale based on iconSize value
+    if (iconSize == "S") {
+      lightModeiconScale = 3;
+      darkModeIconScale = 2;
+    }
 
-            if (iconSize == "M") {
-              lightModeiconScale = 4;
-              darkModeIconScale = 2.666;
-            }
+    if (iconSize == "M") {
+      lightModeiconScale = 4;
+      darkModeIconScale = 2.666;
+    }
 
-            if (iconSize == "L") {
-              lightModeiconScale = 6;
-              darkModeIconScale = 4;
-            }
+    if (iconSize == "L") {
+      lightModeiconScale = 6;
+      darkModeIconScale = 4;
+    }
 
-            if (iconSize == "XL") {
-              lightModeiconScale = 8;
-              darkModeIconScale = 5.333;
-            }
+    if (iconSize == "XL") {
+      lightModeiconScale = 8;
+      darkModeIconScale = 5.333;
+    }
 
-            if (iconSize == "XXL") {
-              lightModeiconScale = 15;
-              darkModeIconScale = 10;
-            }
+    if (iconSize == "XXL") {
+      lightModeiconScale = 15;
+      darkModeIconScale = 10;
+    }
 
-            // disable scaling - all is fusion now
-            // let's leave scaling logic for now
-            darkModeIconScale = lightModeiconScale;
+    // disable scaling - all is fusion now
+    // let's leave scaling logic for now
+    darkModeIconScale = lightModeiconScale;
 
 #if !defined(Q_OS_MACOS)
-            // _inv only for dark mode
-            // we use darkModeIni to apply mode active at startup
-            if (darkModeIni) {
-              if (iconsColour == "white") {
-                img_add = "_inv";
-              } else {
-                img_add = "";
-              }
-            } else {
-              img_add = "";
-            }
+    // _inv only for dark mode
+    // we use darkModeIni to apply mode active at startup
+    if (darkModeIni) {
+      if (iconsColour == "white") {
+        img_add = "_inv";
+      } else {
+        img_add = "";
+      }
+    } else {
+      img_add = "";
+    }
 #if defined(Q_OS_WIN)
-            // on Windows dark theme changes PM_ListViewIconSize size
-            // so we have to adjust
-            if (darkModeIni) {
-              size = darkModeIconScale *
-                     style->pixelMetric(QStyle::PM_ListViewIconSize);
-            } else {
-              size = lightModeiconScale *
-                     style->pixelMetric(QStyle::PM_ListViewIconSize);
-            }
+    // on Windows dark theme changes PM_ListViewIconSize size
+    // so we have to adjust
+    if (darkModeIni) {
+      size = darkModeIconScale *
+             style->pixelMetric(QStyle::PM_ListViewIconSize);
+    } else {
+      size = lightModeiconScale *
+             style->pixelMetric(QStyle::PM_ListViewIconSize);
+    }
 #else
-             // for Linux/BSD PM_ListViewIconSize stays the same
-             size = lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
+     // for Linux/BSD PM_ListViewIconSize stays the same
+     size = lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
 #endif
 #else
-             QString sysInfo = QSysInfo::productVersion();
-             // dark mode on older macOS
-             if (sysInfo == "10.9" ||
-                 sysInfo == "10.10" ||
-                 sysInfo == "10.11" ||
-                 sysInfo == "10.12" ||
-                 sysInfo == "10.13") {
-
-               // on older macOS we also have to adjust icon size per mode
-               if (darkModeIni) {
-                 size = darkModeIconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
-                 if (iconsColour == "white") {
-                   img_add = "_inv";
-                 } else {
-                   img_add = "";
-                 }
-               } else {
-                 size = lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
-                 img_add = "";
-               }
-
-             } else {
-               // for macOS > 10.13 native dark mode does not change IconSize base
-               size = 1.5 * lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
-               if (iconsColour == "white") {
-                  img_add = "_inv";
-               } else {
-                   img_add = "";
-               }
-             }
+     QString sysInfo = QSysInfo::productVersion();
+     // dark mode on older macOS
+     if (sysInfo == "10.9" ||
+         sysInfo == "10.10" ||
+         sysInfo == "10.11" ||
+         sysInfo == "10.12" ||
+         sysInfo == "10.13") {
+
+       // on older macOS we also have to adjust icon size per mode
+       if (darkModeIni) {
+         size = darkModeIconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
+         if (iconsColour == "white") {
+           img_add = "_inv";
+         } else {
+           img_add = "";
+         }
+       } else {
+         size = lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
+         img_add = "";
+       }
+
+     } else {
+       // for macOS > 10.13 native dark mode does not change IconSize base
+       size = 1.5 * lightModeiconScale * style->pixelMetric(QStyle::PM_ListViewIconSize);
+       if (iconsColour == "white") {
+          img_add = "_inv";
+       } else {
+           img_add = "";
+       }
+     }
 #endif
-            ui.remotes->setIconSize(QSize(size, size));
-
-            if (mIconsLayout == "tiles") {
-              ui.remotes->setViewMode(QListWidget::IconMode);
-              // disable drag and drop
-              ui.remotes->setMovement(QListView::Static);
-              // always adjust icons after the window is resized
-              ui.remotes->setResizeMode(QListView::Adjust);
-              ui.remotes->setWrapping(true);
-              ui.remotes->setGridSize(QSize(size + 20, size + 40));
-              ui.remotes->setSpacing(10);
-              ui.remotes->setTextElideMode(Qt::ElideMiddle);
-            }
-            if (mIconsLayout == "longlist") {
-              ui.remotes->setViewMode(QListWidget::ListMode);
-              ui.remotes->setResizeMode(QListView::Adjust);
-              ui.remotes->setWrapping(false);
-              ui.remotes->setGridSize(QSize(size + 800, size + 20));
-            }
-            if (mIconsLayout == "list") {
-              ui.remotes->setViewMode(QListWidget::ListMode);
-              ui.remotes->setResizeMode(QListView::Adjust);
-              ui.remotes->setWrapping(true);
-              ui.remotes->setGridSize(QSize(size + 100, size + 20));
-              ui.remotes->setSpacing(10);
-            }
+    ui.remotes->setIconSize(QSize(size, size));
+
+    if (mIconsLayout == "tiles") {
+      ui.remotes->setViewMode(QListWidget::IconMode);
+      // disable drag and drop
+      ui.remotes->setMovement(QListView::Static);
+      // always adjust icons after the window is resized
+      ui.remotes->setResizeMode(QListView::Adjust);
+      ui.remotes->setWrapping(true);
+      ui.remotes->setGridSize(QSize(size + 20, size + 40));
+      ui.remotes->setSpacing(10);
+      ui.remotes->setTextElideMode(Qt::ElideMiddle);
+    }
+    if (mIconsLayout == "longlist") {
+      ui.remotes->setViewMode(QListWidget::ListMode);
+      ui.remotes->setResizeMode(QListView::Adjust);
+      ui.remotes->setWrapping(false);
+      ui.remotes->setGridSize(QSize(size + 800, size + 20));
+    }
+    if (mIconsLayout == "list") {
+      ui.remotes->setViewMode(QListWidget::ListMode);
+      ui.remotes->setResizeMode(QListView::Adjust);
+      ui.remotes->setWrapping(true);
+      ui.remotes->setGridSize(QSize(size + 100, size + 20));
+      ui.remotes->setSpacing(10);
+    }
 
-            QString path = ":media/images/remotes_icons/" +
-                           type.replace(' ', '_') + img_add + ".png";
-            QIcon icon(QFile(path).exists()
-                           ? path
-                           : ":media/images/remotes_icons/unknown" + img_add +
-                                 ".png");
-
-            QListWidgetItem *item = new QListWidgetItem(icon, name);
-            item->setData(Qt::UserRole, type);
-            item->setToolTip(tooltip);
-            ui.remotes->addItem(item);
-          }
+    QString path = ":media/images/remotes_icons/" +
+                   type.replace(' ', '_') + img_add + ".png";
+    QIcon icon(QFile(path).exists()
+                   ? path
+                   : ":media/images/remotes_icons/unknown" + img_add +
+                         ".png");
+
+    QListWidgetItem *item = new QListWidgetItem(icon, name);
+    item->setData(Qt::UserRole, type);
+    item->setToolTip(tooltip);
+    ui.remotes->addItem(item);
+  }
+}
+
+void MainWindow::rcloneListRemotes() {
+
+  QProcess *p = new QProcess();
+
+  QObject::connect(
+      p,
+      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+          &QProcess::finished),
+      this, [=](int code, QProcess::ExitStatus) {
+        if (code == 0) {
+          QByteArray remotes = p->readAllStandardOutput();
+          showRemotes(QString::fromUtf8(remotes));
+          startupCheckFinished("remotes listed");
+
+          WriteRcloneCache("remotes", remotes);
         } else {
+          ui.remotes->clear();
           if (p->error() != QProcess::FailedToStart) {
-            if (getConfigPassword(p)) {
+            if (mVersionCheckRunning) {
+              // version check running in parallel asks for password and
+              // lists remotes again
+              mListRemotesAfterVersion = true;
+            } else if (getConfigPassword(p)) {
               rcloneListRemotes();
+            } else {
+              startupCheckFinished("remotes listing failed");
             }
           }
         }
@@ -3109,6 +3334,13 @@ void MainWindow::rcloneListRemotes() {
 
   QObject::connect(
       p, &QProcess::errorOccurred, this, [=](QProcess::ProcessError error) {
+        startupCheckFinished("remotes listing failed");
+
+        // reported already by version check started together
+        if (mVersionCheckRunning) {
+          return;
+        }
+
         QString errorString =
             QMetaEnum::fromType<QProcess::ProcessError>().valueToKey(error);
 
@@ -3246,11 +3478,9 @@ void MainWindow::restoreSchedulersFromFile() {
 
       ListOfJobOptions *ljo = ListOfJobOptions::getInstance();
 
-      for (JobOptions *jo : ljo->getTasks()) {
-        if (jo->uniqueId.toString() == schedulerTaskID) {
-          mSchedulersCount++;
-          addScheduler("", "", args);
-        }
+      if (ljo->getTask(schedulerTaskID) != nullptr) {
+        mSchedulersCount++;
+        addScheduler("", "", args);
       }
     }
 
@@ -3278,17 +3508,21 @@ void MainWindow::addTasksToQueue() {
 
   QString fileTaskId;
   QString fileRequestId;
+  QString fileDependsOn;
 
   if (!file.open(QIODevice::ReadOnly)) {
     return;
   } else {
 
     QString taskNameDisplay;
+    QHash<QString, SchedulerWidget *> schedulers = getSchedulersByRequestId();
 
     while (!in.atEnd()) {
 
       QString line = in.readLine();
 
+      fileDependsOn.clear();
+
       if (line.indexOf(",") == -1) {
         // old task file
         fileTaskId = line;
@@ -3296,91 +3530,247 @@ void MainWindow::addTasksToQueue() {
 
       } else {
 
-        fileTaskId = line.left(line.indexOf(","));
-        fileRequestId = line.right(line.length() - (line.indexOf(",") + 1));
+        // taskId,requestId[,requestId of task it has to wait for]
+        QStringList fields = line.split(",");
+        fileTaskId = fields.at(0);
+        fileRequestId = fields.at(1);
+        if (fields.count() > 2) {
+          fileDependsOn = fields.at(2);
+        }
+      }
+
+      JobOptions *jo = ljo->getTask(fileTaskId);
+      if (jo == nullptr) {
+        continue;
       }
 
-      for (JobOptions *jo : ljo->getTasks()) {
+      QIcon jobIcon = mDownloadIcon;
+
+      if (jo->jobType == JobOptions::JobType::Download) {
+        if (jo->operation == JobOptions::Mount) {
+          jobIcon = mMountIcon;
+        } else {
+          jobIcon = mDownloadIcon;
+        }
+      }
+      if (jo->jobType == JobOptions::JobType::Upload) {
+        jobIcon = mUploadIcon;
+      }
+
+      if (jo->operation == JobOptions::Mount) {
+        if (jo->mountAutoStart) {
+          taskNameDisplay = jo->description + "(autostart)";
+        } else {
+          taskNameDisplay = jo->description;
+        }
+      } else {
+        taskNameDisplay = jo->description;
+      }
+
+      // check if task is from scheduler
+      SchedulerWidget *scheduler = schedulers.value(fileRequestId, nullptr);
+      if (scheduler != nullptr) {
+        scheduler->updateTaskStatus(fileRequestId, "in the queue");
+
+        taskNameDisplay = taskNameDisplay + " (*Sch)";
+        mRunningSchedulersCount++;
+        ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
+                                   .arg(mSchedulersCount)
+                                   .arg(mRunningSchedulersCount));
+      }
+
+      JobOptionsListWidgetItem *item = new JobOptionsListWidgetItem(
+          jo, jobIcon, taskNameDisplay, fileRequestId);
+
+      ++mQueueCount;
+      ui.queueListWidget->addItem(item);
+      setQueueDependency(item, fileDependsOn);
+    }
+
+    file.close();
+
+    updateQueueTabText();
+
+    ui.labelQueueInfoStop->setText("Queue is not running.");
+    ui.labelQueueInfoStop->show();
+    ui.labelQueueInfoStart->hide();
+  }
+
+  ui.buttonStopQueue->setEnabled(false);
+  ui.buttonStartQueue->setEnabled(true);
+  ui.buttonDownQueue->setEnabled(false);
+  ui.buttonUpQueue->setEnabled(false);
+  ui.buttonRemoveFromQueue->setEnabled(false);
+
+  if (ui.queueListWidget->count() > 0) {
+    ui.buttonPurgeQueue->setEnabled(true);
+  } else {
+    ui.buttonPurgeQueue->setEnabled(false);
+  }
+}
+
+void MainWindow::showSchedulerCalendar() {
+
+  QList<SchedulerWidget *> schedulers;
+
+  int schedulersCount = ui.schedulers->count();
+  for (int j = 0; j < schedulersCount; j = j + 2) {
+    QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
+    if (auto scheduler = qobject_cast<SchedulerWidget *>(schedulerWidget)) {
+      schedulers << scheduler;
+    }
+  }
+
+  SchedulerCalendarDialog dialog(schedulers, this);
+  dialog.exec();
+}
+
+QHash<QString, SchedulerWidget *> MainWindow::getSchedulersByRequestId() {
+
+  QHash<QString, SchedulerWidget *> schedulers;
+
+  int schedulersCount = ui.schedulers->count();
+  for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
+    QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
+    if (auto scheduler = qobject_cast<SchedulerWidget *>(schedulerWidget)) {
+      schedulers.insert(scheduler->getSchedulerRequestId(), scheduler);
+    }
+  }
+  return schedulers;
+}
+
+QIcon MainWindow::getTaskIcon(JobOptions *jo) {
+
+  if (jo->jobType == JobOptions::JobType::Upload) {
+    return mUploadIcon;
+  }
+  if (jo->operation == JobOptions::Mount) {
+    return mMountIcon;
+  }
+  return mDownloadIcon;
+}
+
+// queue changes below are done in one go - view is repainted, queue file
+// saved and free slots filled once per batch not once per task
+
+void MainWindow::enqueueTasks(const QList<JobOptions *> &tasks) {
+
+  if (tasks.isEmpty()) {
+    return;
+  }
+
+  ui.queueListWidget->setUpdatesEnabled(false);
+  for (JobOptions *jo : tasks) {
+    ui.queueListWidget->addItem(new JobOptionsListWidgetItem(
+        jo, getTaskIcon(jo), jo->description, QUuid::createUuid().toString()));
+  }
+  mQueueCount = mQueueCount + tasks.count();
+  ui.queueListWidget->setUpdatesEnabled(true);
+
+  saveQueueFile();
+
+  // start new tasks if queue is running and there are free slots
+  runQueue();
+  setQueueButtons();
+}
+
+void MainWindow::removeQueueItems(const QList<int> &rows) {
+
+  // from the bottom so remaining rows keep their positions
+  QList<int> sortedRows = rows;
+  std::sort(sortedRows.begin(), sortedRows.end(), std::greater<int>());
+
+  QHash<QString, SchedulerWidget *> schedulers = getSchedulersByRequestId();
+  int removed = 0;
+  int previousRow = -1;
+
+  ui.queueListWidget->setUpdatesEnabled(false);
+  for (int row : sortedRows) {
+
+    // running tasks can't be removed
+    if (row == previousRow || row < mQueueRunningCount ||
+        row >= ui.queueListWidget->count()) {
+      continue;
+    }
+    previousRow = row;
+
+    JobOptionsListWidgetItem *item =
+        static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(row));
+
+    // notify scheduler
+    SchedulerWidget *scheduler = schedulers.value(item->GetRequestId(), nullptr);
+    if (scheduler != nullptr) {
+      scheduler->updateTaskStatus(item->GetRequestId(),
+                                  "removed from the queue");
+      mRunningSchedulersCount--;
+    }
+
+    delete ui.queueListWidget->takeItem(row);
+    ++removed;
+  }
+  ui.queueListWidget->setUpdatesEnabled(true);
+
+  if (removed == 0) {
+    return;
+  }
+
+  mQueueCount = mQueueCount - removed;
+  ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
+                             .arg(mSchedulersCount)
+                             .arg(mRunningSchedulersCount));
 
-        QIcon jobIcon = mDownloadIcon;
+  saveQueueFile();
 
-        if (jo->jobType == JobOptions::JobType::Download) {
-          if (jo->operation == JobOptions::Mount) {
-            jobIcon = mMountIcon;
-          } else {
-            jobIcon = mDownloadIcon;
-          }
-        }
-        if (jo->jobType == JobOptions::JobType::Upload) {
-          jobIcon = mUploadIcon;
-        }
+  // tasks waiting for removed ones can start now
+  runQueue();
+  setQueueButtons();
+}
 
-        if (jo->operation == JobOptions::Mount) {
-          if (jo->mountAutoStart) {
-            taskNameDisplay = jo->description + "(autostart)";
-          } else {
-            taskNameDisplay = jo->description;
-          }
-        } else {
-          taskNameDisplay = jo->description;
-        }
+void MainWindow::moveQueueItems(const QList<int> &rows, int offset) {
 
-        // check if task is from scheduler
-        bool transferModeSch = false;
-        int schedulersCount = ui.schedulers->count();
-        for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-          QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-          if (auto scheduler =
-                  qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-            if (fileRequestId == scheduler->getSchedulerRequestId()) {
-              transferModeSch = true;
-              scheduler->updateTaskStatus(fileRequestId, "in the queue");
-            }
-          }
-        }
+  QList<int> sortedRows = rows;
+  std::sort(sortedRows.begin(), sortedRows.end());
 
-        if (jo->uniqueId.toString() == fileTaskId) {
-          if (transferModeSch) {
-            taskNameDisplay = taskNameDisplay + " (*Sch)";
-            mRunningSchedulersCount++;
-            ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                       .arg(mSchedulersCount)
-                                       .arg(mRunningSchedulersCount));
-          }
+  // running tasks are at the top of the queue and can't be moved
+  QList<QListWidgetItem *> items;
+  for (int row : sortedRows) {
+    if (row >= mQueueRunningCount && row < ui.queueListWidget->count() &&
+        !items.contains(ui.queueListWidget->item(row))) {
+      items << ui.queueListWidget->item(row);
+    }
+  }
 
-          JobOptionsListWidgetItem *item = new JobOptionsListWidgetItem(
-              jo, jobIcon, taskNameDisplay, fileRequestId);
+  if (items.isEmpty() || offset == 0) {
+    return;
+  }
 
-          ++mQueueCount;
-          ui.queueListWidget->addItem(item);
-        }
-      }
-    }
+  int target = ui.queueListWidget->row(items.first()) + offset;
 
-    file.close();
+  ui.queueListWidget->setUpdatesEnabled(false);
+  for (int i = items.count() - 1; i >= 0; i--) {
+    ui.queueListWidget->takeItem(ui.queueListWidget->row(items.at(i)));
+  }
 
-    if (mQueueCount == 0) {
-      ui.tabs->setTabText(3, QString("Queue"));
-    } else {
-      ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-    }
+  target = qBound(mQueueRunningCount, target, ui.queueListWidget->count());
+  for (int i = 0; i < items.count(); i++) {
+    ui.queueListWidget->insertItem(target + i, items.at(i));
+  }
+  ui.queueListWidget->setUpdatesEnabled(true);
 
-    ui.labelQueueInfoStop->setText("Queue is not running.");
-    ui.labelQueueInfoStop->show();
-    ui.labelQueueInfoStart->hide();
+  ui.queueListWidget->setCurrentItem(items.first());
+  for (QListWidgetItem *item : items) {
+    item->setSelected(true);
   }
 
-  ui.buttonStopQueue->setEnabled(false);
-  ui.buttonStartQueue->setEnabled(true);
-  ui.buttonDownQueue->setEnabled(false);
-  ui.buttonUpQueue->setEnabled(false);
-  ui.buttonRemoveFromQueue->setEnabled(false);
+  saveQueueFile();
+}
 
-  if (ui.queueListWidget->count() > 0) {
-    ui.buttonPurgeQueue->setEnabled(true);
-  } else {
-    ui.buttonPurgeQueue->setEnabled(false);
+QList<int> MainWindow::getSelectedQueueRows() {
+  QList<int> rows;
+  for (QListWidgetItem *item : ui.queueListWidget->selectedItems()) {
+    rows << ui.queueListWidget->row(item);
   }
+  return rows;
 }
 
 void MainWindow::listTasks() {
@@ -3478,8 +3868,9 @@ void MainWindow::listTasks() {
           static_cast<JobOptionsListWidgetItem *>(ui.queueListWidget->item(i));
       JobOptions *jo_queue = item_queue->GetData();
       uniqueId_queue = jo_queue->uniqueId.toString();
-      // preserve requestId
+      // preserve requestId and dependency
       QString requestId = item_queue->GetRequestId();
+      QString dependsOn = item_queue->GetDependsOn();
 
       // if no corresponding item found in the queue means task has been deleted
       // and have to be removed from the queue as well
@@ -3502,7 +3893,7 @@ void MainWindow::listTasks() {
             itemFound = true;
             // update ui.queueListWidget
 
-            ui.queueListWidget->takeItem(i);
+            delete ui.queueListWidget->takeItem(i);
 
             QIcon jobIcon = mDownloadIcon;
 
@@ -3541,9 +3932,10 @@ void MainWindow::listTasks() {
                                              requestId);
 
             ui.queueListWidget->insertItem(i, item_insert);
+            setQueueDependency(item_insert, dependsOn);
 
-            if (i == 0 && mQueueStatus) {
-              ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
+            if (i < mQueueRunningCount) {
+              item_insert->setBackground(Qt::darkGreen);
             }
           }
         } // for j
@@ -3555,16 +3947,10 @@ void MainWindow::listTasks() {
         if (!itemFound) {
           // only if already running leave it
           // never should happen - as not possible to delete already running
-          if (i != 0) {
+          if (i >= mQueueRunningCount) {
             --mQueueCount;
-            ui.queueListWidget->takeItem(i);
-            if (mQueueCount == 0) {
-              ui.tabs->setTabText(3,
-                                  QString("Queue (%1)>>(0)").arg(mQueueCount));
-            } else {
-              ui.tabs->setTabText(
-                  3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-            }
+            delete ui.queueListWidget->takeItem(i);
+            updateQueueTabText();
           }
         }
 
@@ -3572,12 +3958,8 @@ void MainWindow::listTasks() {
         // stopped queue
         if (!itemFound) {
           --mQueueCount;
-          ui.queueListWidget->takeItem(i);
-          if (mQueueCount == 0) {
-            ui.tabs->setTabText(3, QString("Queue"));
-          } else {
-            ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-          }
+          delete ui.queueListWidget->takeItem(i);
+          updateQueueTabText();
         }
 
       } // mQueueStatus
@@ -3938,12 +4320,7 @@ void MainWindow::runItem(JobOptionsListWidgetItem *item,
     if (!jo->extra.trimmed().isEmpty()) {
       for (auto line : jo->extra.trimmed().split('\n')) {
         if (!line.isEmpty()) {
-          for (QString arg :
-               line.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-            if (!arg.isEmpty()) {
-              args << arg.replace("\"", "");
-            }
-          }
+          args << SplitCommandLine(line);
         }
       }
     }
@@ -4039,21 +4416,16 @@ void MainWindow::editSelectedTask() {
 }
 
 bool MainWindow::saveQueueFile(void) {
+  mQueueFileWriter->schedule();
+  return true;
+}
 
-  QMutexLocker locker(&mSaveQueueFileMutex);
-  QString filePath = GetConfigDir().absoluteFilePath("queue.conf");
-
-#if QT_VERSION < QT_VERSION_CHECK(5, 1, 0)
-  QFile file(filePath);
-#else
-  QSaveFile file(filePath);
-#endif
+QByteArray MainWindow::getQueueFileContent(void) {
 
-  if (!file.open(QIODevice::WriteOnly)) {
-    return false;
-  }
+  QMutexLocker locker(&mSaveQueueFileMutex);
 
-  QTextStream out(&file);
+  QByteArray data;
+  QTextStream out(&data, QIODevice::WriteOnly);
 
   // loop over ui.queueListWidget
   for (int i = 0; i < ui.queueListWidget->count(); ++i) {
@@ -4064,39 +4436,32 @@ bool MainWindow::saveQueueFile(void) {
 
     JobOptions *jo = jobItem->GetData();
 
+    out << jo->uniqueId.toString() << "," << jobItem->GetRequestId();
+    if (!jobItem->GetDependsOn().isEmpty()) {
+      out << "," << jobItem->GetDependsOn();
+    }
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 1)
-    out << jo->uniqueId.toString() << "," << jobItem->GetRequestId()
-        << Qt::endl;
+    out << Qt::endl;
 #else
-    out << jo->uniqueId.toString() << "," << jobItem->GetRequestId() << endl;
+    out << endl;
 #endif
   }
 
   out.flush();
-
-#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
-  return out.status() == QTextStream::Ok && file.commit();
-#else
-  return out.status() == QTextStream::Ok;
-#endif
+  return data;
 }
 
 bool MainWindow::saveSchedulerFile(void) {
+  mSchedulerFileWriter->schedule();
+  return true;
+}
 
-  QMutexLocker locker(&mSaveSchedulerFileMutex);
-  QString filePath = GetConfigDir().absoluteFilePath("scheduler.conf");
-
-#if QT_VERSION < QT_VERSION_CHECK(5, 1, 0)
-  QFile file(filePath);
-#else
-  QSaveFile file(filePath);
-#endif
+QByteArray MainWindow::getSchedulerFileContent(void) {
 
-  if (!file.open(QIODevice::WriteOnly)) {
-    return false;
-  };
+  QMutexLocker locker(&mSaveSchedulerFileMutex);
 
-  QTextStream out(&file);
+  QByteArray data;
+  QTextStream out(&data, QIODevice::WriteOnly);
   int schedulersCount = ui.schedulers->count();
 
   for (int i = schedulersCount - 2; i >= 0; i = i - 2) {
@@ -4113,12 +4478,13 @@ bool MainWindow::saveSchedulerFile(void) {
   }
 
   out.flush();
+  return data;
+}
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
-  return out.status() == QTextStream::Ok && file.commit();
-#else
-  return out.status() == QTextStream::Ok;
-#endif
+// write pending queue and scheduler changes before quitting
+void MainWindow::flushConfigFiles(void) {
+  mQueueFileWriter->flush();
+  mSchedulerFileWriter->flush();
 }
 
 void MainWindow::addSavedTransfer(const QString &uniqueId, bool dryRun,
@@ -4145,71 +4511,7 @@ void MainWindow::addSavedTransfer(const QString &uniqueId, bool dryRun,
         break;
       } else {
         // add to queue
-
-        bool isQueueEmpty = (ui.queueListWidget->count() == 0);
-
-        QIcon jobIcon;
-
-        if (joTask->jobType == JobOptions::JobType::Download) {
-          if (joTask->operation == JobOptions::Mount) {
-            jobIcon = mMountIcon;
-          } else {
-            jobIcon = mDownloadIcon;
-          }
-        }
-        if (joTask->jobType == JobOptions::JobType::Upload) {
-          jobIcon = mUploadIcon;
-        }
-
-        JobOptionsListWidgetItem *newitem =
-            new JobOptionsListWidgetItem(joTask, jobIcon, joTask->description,
-                                         QUuid::createUuid().toString());
-
-        ui.queueListWidget->addItem(newitem);
-        mQueueCount = mQueueCount + 1;
-
-        // if queue was empty we start first taks if queue is running and
-        // there is no other transfer job running
-        if (mQueueStatus && isQueueEmpty && (mTransferJobCount == 0)) {
-
-          if (mQueueCount > 0) {
-
-            JobOptionsListWidgetItem *item =
-                static_cast<JobOptionsListWidgetItem *>(
-                    ui.queueListWidget->item(0));
-
-            runItem(item, "scheduler", item->GetRequestId());
-            ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-            mQueueTaskRunning = true;
-            ui.tabs->setTabText(
-                3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-          }
-
-        } else {
-
-          if (mQueueStatus) {
-
-            if (mQueueCount == 0) {
-              ui.tabs->setTabText(3,
-                                  QString("Queue (%1)>>(0)").arg(mQueueCount));
-            } else {
-              if (!mQueueTaskRunning) {
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-              } else {
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-              }
-            }
-          } else {
-            if (mQueueCount == 0) {
-              ui.tabs->setTabText(3, QString("Queue"));
-            } else {
-              ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-            }
-          }
-        }
-        saveQueueFile();
+        enqueueTasks(QList<JobOptions *>() << joTask);
         break;
       }
     }
@@ -4228,6 +4530,20 @@ void MainWindow::addTransfer(const QString &message, const QString &source,
   auto widget = new JobWidget(transfer, message, args, source, dest, uniqueId,
                               transferMode, requestId);
 
+  // start transfer with remote control enabled so its bandwidth can be
+  // changed (or transfer paused) without restarting it
+  QStringList rcArgs;
+  int rcPort = AcquireRcPort();
+  if (rcPort != 0) {
+    QString rcUser = GenerateRcCredential(10);
+    QString rcPass = GenerateRcCredential(22);
+    rcArgs << "--rc"
+           << "--rc-addr"
+           << "localhost:" + QString::number(rcPort);
+    rcArgs << "--rc-user=" + rcUser << "--rc-pass=" + rcPass;
+    widget->setRcEndpoint(rcPort, rcUser, rcPass);
+  }
+
   auto line = new QFrame();
   line->setFrameShape(QFrame::HLine);
   line->setFrameShadow(QFrame::Sunken);
@@ -4238,6 +4554,10 @@ void MainWindow::addTransfer(const QString &message, const QString &source,
       [=](const QString &info, const QString &jobFinalStatus) {
         QMutexLocker locker(&mMutex);
 
+        ReleaseRcPort(widget->getRcPort());
+
+        JobHistory::getInstance()->add(widget->getHistoryRecord());
+
         if (mNotifyFinishedTransfers) {
           mLastFinished = widget;
 #if defined(Q_OS_WIN)
@@ -4311,120 +4631,61 @@ void MainWindow::addTransfer(const QString &message, const QString &source,
           }
         }
 
-        // if job finished try to run next one from the queue
-        // only when not quitting, queue is active and there are tasks in the
-        // queue and there is no running other task
-
-        if (!mAppQuittingStatus && mQueueStatus &&
-            ui.queueListWidget->count() > 0) {
-          //            ui.queueListWidget->count() > 0 && mTransferJobCount ==
-          //            0) {
+        // if job finished release its queue slot and try to run next ones
+        // from the queue - only when not quitting
+        // (when quitting job is not removed from the queue)
+        JobOptionsListWidgetItem *keptInQueue = nullptr;
 
-          auto QueueRunningTask = ui.queueListWidget->item(0);
-
-          JobOptionsListWidgetItem *item =
-              static_cast<JobOptionsListWidgetItem *>(QueueRunningTask);
-          JobOptions *jo = item->GetData();
-
-          // check if finished task the same as running from the queue
-          auto transfer = qobject_cast<JobWidget *>(widget);
+        if (!mAppQuittingStatus) {
 
+          // running queued tasks are at the top of the queue
           // we also have to check requestId - to distinguish between the same
-          // task triggered by queue/scheduler and by user directly if yes we
-          // try to run next one
-          if ((transfer->getUniqueID() == jo->uniqueId.toString()) &&
-              (transfer->getRequestId() == item->GetRequestId())) {
-            ui.queueListWidget->takeItem(0);
-            --mQueueCount;
-
-            // queue is still running, even if mQueueCount is 0
-            if (mQueueCount == 0) {
-              mQueueTaskRunning = false;
-              ui.tabs->setTabText(3,
-                                  QString("Queue (%1)>>(0)").arg(mQueueCount));
-              // run queueScript
-              auto settings = GetSettings();
-              bool queueScriptRun =
-                  settings->value("Settings/queueScriptRun", false).toBool();
-
-              if (queueScriptRun) {
-                QString queueScript =
-                    settings->value("Settings/queueScript").toString();
-                if (!queueScript.isEmpty()) {
-                  runScript(queueScript);
-                }
-              }
-            }
+          // task triggered by queue/scheduler and by user directly
+          for (int i = 0; i < mQueueRunningCount; i++) {
+            JobOptionsListWidgetItem *item =
+                static_cast<JobOptionsListWidgetItem *>(
+                    ui.queueListWidget->item(i));
+            JobOptions *jo = item->GetData();
 
-            // if there is still task to run
-            if ((ui.queueListWidget->count()) > 0) {
+            if ((transfer->getUniqueID() == jo->uniqueId.toString()) &&
+                (transfer->getRequestId() == item->GetRequestId())) {
 
-              auto nextTask = ui.queueListWidget->item(0);
-              // check if task is not already running (user could run it
-              // manually)
+              ui.queueListWidget->takeItem(i);
+              --mQueueRunningCount;
 
-              bool isAlreadyRunning = false;
+              if (mQueueStatus) {
+                delete item;
+                --mQueueCount;
 
-              JobOptionsListWidgetItem *item =
-                  static_cast<JobOptionsListWidgetItem *>(nextTask);
-              JobOptions *jo = item->GetData();
+                if (mQueueCount == 0) {
+                  // run queueScript
+                  auto settings = GetSettings();
+                  bool queueScriptRun =
+                      settings->value("Settings/queueScriptRun", false)
+                          .toBool();
 
-              int widgetsCount = ui.jobs->count();
-              for (int j = widgetsCount - 2; j >= 0; j = j - 2) {
-                QWidget *widget = ui.jobs->itemAt(j)->widget();
-                if (auto transfer = qobject_cast<JobWidget *>(widget)) {
-                  if ((transfer->getUniqueID() == jo->uniqueId.toString()) &&
-                      (transfer->isRunning)) {
-                    isAlreadyRunning = true;
-                    break;
+                  if (queueScriptRun) {
+                    QString queueScript =
+                        settings->value("Settings/queueScript").toString();
+                    if (!queueScript.isEmpty()) {
+                      runScript(queueScript);
+                    }
                   }
                 }
-              }
-
-              // if the same task not running and nothing else running
-              if (!isAlreadyRunning && mTransferJobCount == 0) {
-                mQueueTaskRunning = true;
-                runItem(item, "queue", item->GetRequestId());
-
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-
-                ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
               } else {
-
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-
-                mQueueTaskRunning = false;
-              }
-            }
-            saveQueueFile();
-          } else {
-            // finished task was not one from the queue
-            // queue is active and have some tasks and if there is nothing else
-            // running we start top task from the queue
-            if (!mQueueTaskRunning) {
-              auto nextTask = ui.queueListWidget->item(0);
-
-              JobOptionsListWidgetItem *item =
-                  static_cast<JobOptionsListWidgetItem *>(nextTask);
-
-              if (mTransferJobCount == 0) {
-
-                mQueueTaskRunning = true;
-                runItem(item, "queue", item->GetRequestId());
-                ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
+                // queue was stopped - task stays first in the queue
+                item->setBackground(QBrush());
+                ui.queueListWidget->insertItem(mQueueRunningCount, item);
+                keptInQueue = item;
               }
 
-            } else {
-
-              // mQueueTaskRunning = false;
-              ui.tabs->setTabText(
-                  3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
+              saveQueueFile();
+              break;
             }
           }
+
+          // slot released - start next tasks
+          runQueue();
         }
 
         setTasksButtons();
@@ -4454,31 +4715,22 @@ void MainWindow::addTransfer(const QString &message, const QString &source,
         // then scheduled task is "in the queue" not "stopped"
         // we notify schedulers what is still in the queue
 
-        if (mQueueStatus == false) {
-          int itemsCount = ui.queueListWidget->count();
-          if (itemsCount > 0) {
-            JobOptionsListWidgetItem *item_queue =
-                static_cast<JobOptionsListWidgetItem *>(
-                    ui.queueListWidget->item(0));
-
-            int schedulersCount = ui.schedulers->count();
-            for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
-              QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
-
-              if (auto scheduler =
-                      qobject_cast<SchedulerWidget *>(schedulerWidget)) {
-                // jobFinalStatus = stopped, error, finished
-                scheduler->updateTaskStatus(item_queue->GetRequestId(),
-                                            "in the queue");
-
-                if (transfer->getRequestId() ==
-                        scheduler->getSchedulerRequestId() &&
-                    transfer->getRequestId() == item_queue->GetRequestId()) {
-                  mRunningSchedulersCount++;
-                  ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
-                                             .arg(mSchedulersCount)
-                                             .arg(mRunningSchedulersCount));
-                }
+        if (keptInQueue != nullptr) {
+          int schedulersCount = ui.schedulers->count();
+          for (int j = schedulersCount - 2; j >= 0; j = j - 2) {
+            QWidget *schedulerWidget = ui.schedulers->itemAt(j)->widget();
+
+            if (auto scheduler =
+                    qobject_cast<SchedulerWidget *>(schedulerWidget)) {
+              scheduler->updateTaskStatus(keptInQueue->GetRequestId(),
+                                          "in the queue");
+
+              if (transfer->getRequestId() ==
+                  scheduler->getSchedulerRequestId()) {
+                mRunningSchedulersCount++;
+                ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
+                                           .arg(mSchedulersCount)
+                                           .arg(mRunningSchedulersCount));
               }
             }
           }
@@ -4556,8 +4808,19 @@ void MainWindow::addTransfer(const QString &message, const QString &source,
   ui.buttonStopAllJobs->setEnabled(mTransferJobCount != 0);
   ui.buttonCleanNotRunning->setEnabled(mJobCount != (ui.jobs->count() - 2) / 2);
 
+  // finished is not emitted when rclone can't be started
+  // release rc port here so it is not leaked
+  QObject::connect(transfer, &QProcess::errorOccurred, this,
+                   [=](QProcess::ProcessError error) {
+                     if (error == QProcess::FailedToStart && rcPort != 0) {
+                       ReleaseRcPort(rcPort);
+                       widget->setRcEndpoint(0, QString(), QString());
+                     }
+                   });
+
   UseRclonePassword(transfer);
-  transfer->start(GetRclone(), args + GetRcloneConf(), QIODevice::ReadOnly);
+  transfer->start(GetRclone(), args + rcArgs + GetRcloneConf(),
+                  QIODevice::ReadOnly);
 
   ui.buttonStopAllJobs->setEnabled(mTransferJobCount != 0);
   ui.buttonCleanNotRunning->setEnabled(mJobCount != (ui.jobs->count() - 2) / 2);
@@ -4580,13 +4843,7 @@ void MainWindow::runScript(const QString &script) {
                      p->deleteLater();
                    });
 
-  QStringList scriptList;
-
-  for (QString arg : script.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-    if (!arg.isEmpty()) {
-      scriptList << arg.replace("\"", "");
-    }
-  }
+  QStringList scriptList = SplitCommandLine(script);
 
   QString scriptCmd = scriptList.takeAt(0);
   QStringList scriptArgs = scriptList;
@@ -4614,19 +4871,7 @@ void MainWindow::addNewMount(const QString &remote, const QString &folder,
   ui.tabs->setTabText(1, QString("Jobs (%1)").arg(++mJobCount));
 
   // get default mount options
-  auto settings = GetSettings();
-  QString opt = settings->value("Settings/mount").toString();
-
-  if (!opt.isEmpty()) {
-    // split on spaces but not if inside quotes e.g. --option-1 --option-2="arg1
-    // arg2" --option-3 arg3 should generate "--option-1" "--option-2=\"arg1
-    // arg2\"" "--option-3" "arg3"
-    for (QString arg : opt.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-      if (!arg.isEmpty()) {
-        argsFinal << arg.replace("\"", "");
-      }
-    }
-  }
+  argsFinal << GetDefaultOptionsList("mount");
 
   argsFinal << GetRcloneConf();
 
@@ -4761,22 +5006,6 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
             ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
                                        .arg(mSchedulersCount)
                                        .arg(mRunningSchedulersCount));
-
-            if (ui.queueListWidget->count() > 0) {
-              for (int i = 0; i < ui.queueListWidget->count(); i++) {
-
-                JobOptionsListWidgetItem *item_queue =
-                    static_cast<JobOptionsListWidgetItem *>(
-                        ui.queueListWidget->item(i));
-
-                if (item_queue->GetRequestId() == requestID) {
-
-                  ui.queueListWidget->takeItem(i);
-
-                  break;
-                }
-              }
-            }
           }
         }
       }
@@ -4791,10 +5020,11 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
             static_cast<JobOptionsListWidgetItem *>(
                 ui.queueListWidget->item(i));
 
-        if (item_queue->GetRequestId() == requestID) {
+        if (item_queue->GetRequestId() == requestID &&
+            i >= mQueueRunningCount) {
 
           --mQueueCount;
-          ui.queueListWidget->takeItem(i);
+          delete ui.queueListWidget->takeItem(i);
           widget->updateTaskStatus(requestID, "removed from the queue");
           mRunningSchedulersCount--;
           ui.tabs->setTabText(4, QString("Scheduler (%1)>>(%2)")
@@ -4805,26 +5035,8 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
         }
       }
 
-      if (mQueueStatus) {
-
-        if (mQueueCount == 0) {
-          ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-        } else {
-
-          if (!mQueueTaskRunning) {
-            ui.tabs->setTabText(3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-          } else {
-            ui.tabs->setTabText(
-                3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-          }
-        }
-      } else {
-        if (mQueueCount == 0) {
-          ui.tabs->setTabText(3, QString("Queue"));
-        } else {
-          ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-        }
-      }
+      saveQueueFile();
+      runQueue();
     }
     mDoNotSort = false;
     sortJobs();
@@ -4869,6 +5081,8 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
     QString taskID = widget->getSchedulerTaskId();
     QString requestID = widget->getSchedulerRequestId();
     int executionMode = widget->getExecutionMode();
+    auto settings = GetSettingsSnapshot();
+    int remoteCap = settings->value("Settings/schedulerRemoteCap").toInt();
 
     // find task based on taskID
     for (int k = 0; k < ui.tasksListWidget->count(); k = k + 1) {
@@ -4878,6 +5092,16 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
 
       if (taskID == joTask->uniqueId.toString()) {
 
+        // remote already has enough running transfers - wait in the queue
+        // ahead of other tasks (only when queue runs, otherwise it would
+        // never start)
+        bool priority = false;
+        if (executionMode == 0 && mQueueStatus &&
+            isRemoteBusy(GetTaskRemotes(joTask), remoteCap)) {
+          executionMode = 1;
+          priority = true;
+        }
+
         if (executionMode == 0) {
           // run immediately
           mRunningSchedulersCount++;
@@ -4907,8 +5131,6 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
             }
           }
 
-          bool isQueueEmpty = (ui.queueListWidget->count() == 0);
-
           QIcon jobIcon;
 
           if (joTask->jobType == JobOptions::JobType::Download) {
@@ -4925,7 +5147,12 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
           JobOptionsListWidgetItem *newitem = new JobOptionsListWidgetItem(
               joTask, jobIcon, joTask->description + " (*Sch)", requestID);
 
-          ui.queueListWidget->addItem(newitem);
+          if (priority) {
+            newitem->SetPriority(true);
+            ui.queueListWidget->insertItem(getQueuePriorityRow(), newitem);
+          } else {
+            ui.queueListWidget->addItem(newitem);
+          }
           mQueueCount = mQueueCount + 1;
 
           widget->updateTaskStatus(requestID, "in the queue");
@@ -4934,47 +5161,8 @@ void MainWindow::addScheduler(const QString &taskId, const QString &taskName,
                                      .arg(mSchedulersCount)
                                      .arg(mRunningSchedulersCount));
 
-          // if queue was empty we start first taks if queue is running and
-          // there is no other transfer job running
-          if (mQueueStatus && isQueueEmpty && (mTransferJobCount == 0)) {
-
-            if (mQueueCount > 0) {
-
-              JobOptionsListWidgetItem *item =
-                  static_cast<JobOptionsListWidgetItem *>(
-                      ui.queueListWidget->item(0));
-
-              runItem(item, "scheduler", item->GetRequestId());
-              ui.queueListWidget->item(0)->setBackground(Qt::darkGreen);
-              mQueueTaskRunning = true;
-              ui.tabs->setTabText(
-                  3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-            }
-
-          } else {
-
-            if (mQueueStatus) {
-
-              if (mQueueCount == 0) {
-                ui.tabs->setTabText(
-                    3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-              } else {
-                if (!mQueueTaskRunning) {
-                  ui.tabs->setTabText(
-                      3, QString("Queue (%1)>>(0)").arg(mQueueCount));
-                } else {
-                  ui.tabs->setTabText(
-                      3, QString("Queue (%1)>>(1)").arg(mQueueCount - 1));
-                }
-              }
-            } else {
-              if (mQueueCount == 0) {
-                ui.tabs->setTabText(3, QString("Queue"));
-              } else {
-                ui.tabs->setTabText(3, QString("Queue (%1)").arg(mQueueCount));
-              }
-            }
-          }
+          // start it if queue is running and there is free slot
+          runQueue();
           saveQueueFile();
         }
       }
@@ -5086,13 +5274,7 @@ void MainWindow::addStream(const QString &remote, const QString &stream,
   ui.buttonSortByTime->setEnabled(_jobsCount > 1);
   ui.buttonSortByStatus->setEnabled(_jobsCount > 1);
 
-  QStringList streamPrefsList;
-
-  for (QString arg : stream.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-    if (!arg.isEmpty()) {
-      streamPrefsList << arg.replace("\"", "");
-    }
-  }
+  QStringList streamPrefsList = SplitCommandLine(stream);
 
   QString streamCmd = streamPrefsList.takeAt(0);
   QStringList streamArgs = streamPrefsList;
@@ -5145,98 +5327,71 @@ void MainWindow::sortJobs() {
     return;
   }
 
-  int widgetsCount = ui.jobs->count();
-  int move;
-  QDateTime dt;
-  QDateTime widgetStartDateTime;
-  QString widgetStatus = 0;
-  QString ws;
-
-  for (int i = 0; i < (widgetsCount - 2) / 2 - 1; i = i + 1) {
-
-    for (int j = widgetsCount - 4; j >= i * 2; j = j - 2) {
-
-      QWidget *widget = ui.jobs->itemAt(j)->widget();
-
-      if (auto transfer = qobject_cast<JobWidget *>(widget)) {
-        widgetStartDateTime = transfer->getStartDateTime();
-        widgetStatus = transfer->getStatus();
-
-      } else if (auto mount = qobject_cast<MountWidget *>(widget)) {
-        widgetStartDateTime = mount->getStartDateTime();
-        widgetStatus = mount->getStatus();
+  // jobs layout holds (job widget, line) pairs followed by two extra items
+  struct JobEntry {
+    QWidget *widget;
+    QWidget *line;
+    QDateTime startDateTime;
+    QString status;
+  };
 
-      } else if (auto stream = qobject_cast<StreamWidget *>(widget)) {
-        widgetStartDateTime = stream->getStartDateTime();
-        widgetStatus = stream->getStatus();
-      }
+  QList<JobEntry> entries;
+  int widgetsCount = ui.jobs->count();
 
-      if (mJobsSort == "byDate") {
-        if (j == widgetsCount - 4) {
-          move = j;
-          dt = widgetStartDateTime;
-        } else {
-          if (mJobsTimeSortOrder) {
-            if (dt > widgetStartDateTime) {
-              move = j;
-              dt = widgetStartDateTime;
-            }
-          } else {
-            if (dt < widgetStartDateTime) {
-              move = j;
-              dt = widgetStartDateTime;
-            }
-          }
-        }
-      }
+  for (int j = 0; j < widgetsCount - 2; j = j + 2) {
+    JobEntry entry;
+    entry.widget = ui.jobs->itemAt(j)->widget();
+    entry.line = ui.jobs->itemAt(j + 1)->widget();
+
+    if (auto transfer = qobject_cast<JobWidget *>(entry.widget)) {
+      entry.startDateTime = transfer->getStartDateTime();
+      entry.status = transfer->getStatus();
+    } else if (auto mount = qobject_cast<MountWidget *>(entry.widget)) {
+      entry.startDateTime = mount->getStartDateTime();
+      entry.status = mount->getStatus();
+    } else if (auto stream = qobject_cast<StreamWidget *>(entry.widget)) {
+      entry.startDateTime = stream->getStartDateTime();
+      entry.status = stream->getStatus();
+    } else {
+      break;
+    }
+    entries << entry;
+  }
 
-      if (mJobsSort == "byStatus") {
+  if (entries.count() < 2) {
+    return;
+  }
 
-        if (j == widgetsCount - 4) {
-          move = j;
-          ws = widgetStatus;
-        } else {
-          if (mJobsStatusSortOrder) {
-            if (ws > widgetStatus) {
-              move = j;
-              ws = widgetStatus;
-            }
-          } else {
-            if (ws < widgetStatus) {
-              move = j;
-              ws = widgetStatus;
-            }
-          }
-        }
-      }
+  bool byStatus = (mJobsSort == "byStatus");
+  bool ascending = byStatus ? mJobsStatusSortOrder : mJobsTimeSortOrder;
 
-    } // for (int j
+  std::stable_sort(entries.begin(), entries.end(),
+                   [=](const JobEntry &a, const JobEntry &b) {
+                     if (byStatus) {
+                       return ascending ? a.status < b.status
+                                        : a.status > b.status;
+                     }
+                     return ascending ? a.startDateTime < b.startDateTime
+                                      : a.startDateTime > b.startDateTime;
+                   });
 
-    // move to top
-    QWidget *widget = ui.jobs->itemAt(move)->widget();
-    QWidget *widget_line = ui.jobs->itemAt(move + 1)->widget();
-    auto line = qobject_cast<QFrame *>(widget_line);
+  // move only widgets which are not in place yet, all in one repaint
+  QWidget *jobsWidget = ui.jobs->parentWidget();
+  bool updatesEnabled = jobsWidget->updatesEnabled();
+  jobsWidget->setUpdatesEnabled(false);
 
-    if (auto transfer = qobject_cast<JobWidget *>(widget)) {
-      ui.jobs->removeWidget(transfer);
-      ui.jobs->removeWidget(line);
-      ui.jobs->insertWidget(i * 2, transfer);
-      ui.jobs->insertWidget(i * 2 + 1, line);
-    } else if (auto mount = qobject_cast<MountWidget *>(widget)) {
-      ui.jobs->removeWidget(mount);
-      ui.jobs->removeWidget(line);
-      ui.jobs->insertWidget(i * 2, mount);
-      ui.jobs->insertWidget(i * 2 + 1, line);
-    } else if (auto stream = qobject_cast<StreamWidget *>(widget)) {
-      ui.jobs->removeWidget(stream);
-      ui.jobs->removeWidget(line);
-      ui.jobs->insertWidget(i * 2, stream);
-      ui.jobs->insertWidget(i * 2 + 1, line);
-    } else {
-      //
-      break;
+  for (int i = 0; i < entries.count(); i++) {
+    const JobEntry &entry = entries.at(i);
+    if (ui.jobs->itemAt(i * 2)->widget() == entry.widget) {
+      continue;
     }
-  } //  for (int i
+    ui.jobs->removeWidget(entry.widget);
+    ui.jobs->removeWidget(entry.line);
+    ui.jobs->insertWidget(i * 2, entry.widget);
+    ui.jobs->insertWidget(i * 2 + 1, entry.line);
+  }
+
+  jobsWidget->setUpdatesEnabled(updatesEnabled);
 
   return;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "deferred_file_writer.h"
 #include "icon_cache.h"
 #include "job_options.h"
 #include "pch.h"
@@ -8,6 +9,8 @@
 #endif
 
 class JobWidget;
+class SchedulerWidget;
+class PreferencesDialog;
 
 class MainWindow : public QMainWindow {
   Q_OBJECT
@@ -43,10 +46,13 @@ private slots:
 
   void slotCloseTab(int index);
 
+  // changes are written in background shortly after the last request
   bool saveQueueFile(void);
   bool saveSchedulerFile(void);
+  void flushConfigFiles(void);
 
   void autoStartMounts(void);
+  void restoreSession(void);
 
   // quit RB but only when all processes finished
   void quitApp(void);
@@ -64,9 +70,27 @@ private:
 
   QLabel *mStatusMessage;
 
+  PreferencesDialog *mPreferencesDialog = nullptr;
+
   IconCache mIcons;
 
   bool mFirstTime = true;
+
+  // startup phases with time since start, written to startup.log in config
+  // folder once rclone version check and remotes listing finished
+  QElapsedTimer mStartupTimer;
+  QStringList mStartupTrace;
+  int mStartupChecksPending = 0;
+  void traceStartup(const QString &phase);
+  void startupCheckFinished(const QString &phase);
+  void writeStartupTrace(void);
+
+  // at startup remotes are listed in parallel with version check
+  bool mVersionCheckRunning = false;
+  bool mListRemotesAfterVersion = true;
+  void showRemotes(const QString &remotes);
+  void showRcloneVersion(const QString &version);
+  void checkForUpdates(void);
   int mJobCount = 0;
 
   // keep track of number of active transfers
@@ -81,8 +105,8 @@ private:
 
   // number of queued tasks
   int mQueueCount = 0;
-  // is queued task running
-  bool mQueueTaskRunning = false;
+  // number of running queued tasks - they are kept at the top of the queue
+  int mQueueRunningCount = 0;
 
   // make queue logic aware that app is quiting
   // so job is not removed from the queue
@@ -99,6 +123,32 @@ private:
   QList<QListWidgetItem *> sortListWidget(const QList<QListWidgetItem *> &list,
                                           bool sortOrder = false);
 
+  // start queued tasks while there are free slots
+  void runQueue(void);
+  void updateQueueTabText(void);
+  // automatic order of waiting tasks and queue finish estimate based on
+  // history of previous runs
+  void orderQueue(void);
+  void updateQueueEta(void);
+  void switchToManualQueueOrder(void);
+  QList<qint64>
+  getQueueRunningRemaining(const QHash<QString, qint64> &estimates);
+  void setQueueDependency(JobOptionsListWidgetItem *item,
+                          const QString &requestId);
+  int getQueuePriorityRow(void);
+  bool isRemoteBusy(const QStringList &remotes, int cap);
+
+  // schedulers keyed by request id of their current run
+  QHash<QString, SchedulerWidget *> getSchedulersByRequestId();
+  void showSchedulerCalendar();
+
+  // batch queue operations - one view update and one queue file write
+  void enqueueTasks(const QList<JobOptions *> &tasks);
+  void removeQueueItems(const QList<int> &rows);
+  void moveQueueItems(const QList<int> &rows, int offset);
+  QList<int> getSelectedQueueRows();
+  QIcon getTaskIcon(JobOptions *jo);
+
   // set screen buttons logic mess in one place
   void setQueueButtons(void);
   void setTasksButtons(void);
@@ -119,6 +169,11 @@ private:
 
   // used for tasks transitions - prevent race conditions
   QMutex mMutex;
+  DeferredFileWriter *mQueueFileWriter;
+  DeferredFileWriter *mSchedulerFileWriter;
+  QByteArray getQueueFileContent(void);
+  QByteArray getSchedulerFileContent(void);
+
   QMutex mSaveQueueFileMutex;
   QMutex mSaveSchedulerFileMutex;
   QMutex mStopTaskMutex;
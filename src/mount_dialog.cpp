@@ -525,12 +525,7 @@ QStringList MountDialog::getOptions() {
     for (auto line : ui.textExtra->toPlainText().trimmed().split('\n')) {
       if (!line.isEmpty()) {
 
-        for (QString arg :
-             line.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-          if (!arg.isEmpty()) {
-            list << arg.replace("\"", "");
-          }
-        }
+        list << SplitCommandLine(line);
       }
     }
   }
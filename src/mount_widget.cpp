@@ -46,7 +46,7 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
 
   ui.details->setVisible(false);
 
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
 
   int fontsize = 0;
   fontsize = (settings->value("Settings/fontSize").toInt());
@@ -56,7 +56,6 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
 #endif
 
   QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-  QFontMetrics fm(font);
 
   font.setPointSize(font.pointSize() + fontsize);
 
@@ -79,29 +78,18 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
 
   QString iconsColour = settings->value("Settings/iconsColour").toString();
 
-  QString img_add = "";
-
-  if (iconsColour == "white") {
-    img_add = "_inv";
-  }
-
-  ui.showDetails->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
   ui.showDetails->setIconSize(QSize(24, 24));
-  ui.showOutput->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
   ui.showOutput->setIconSize(QSize(24, 24));
 
-  ui.showScriptOutput->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showScriptOutput->setIcon(GetButtonIcon("vrightarrow"));
   ui.showScriptOutput->setIconSize(QSize(24, 24));
 
-  ui.cancel->setIcon(
-      QIcon(":media/images/qbutton_icons/cancel" + img_add + ".png"));
+  ui.cancel->setIcon(GetButtonIcon("cancel"));
   ui.cancel->setIconSize(QSize(24, 24));
 
-  ui.copy->setIcon(
-      QIcon(":media/images/qbutton_icons/copy" + img_add + ".png"));
+  ui.copy->setIcon(GetButtonIcon("copy"));
   ui.copy->setIconSize(QSize(24, 24));
 
   ui.showDetails->setStyleSheet(
@@ -114,12 +102,10 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
       ui.showDetails, &QToolButton::toggled, this, [=](bool checked) {
         ui.details->setVisible(checked);
         if (checked) {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vdownarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         } else {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         }
       });
@@ -189,12 +175,10 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
         ui.l_script->setVisible(checked);
 
         if (checked) {
-          ui.showScriptOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showScriptOutput->setIcon(GetButtonIcon("vdownarrow"));
           ui.showScriptOutput->setIconSize(QSize(24, 24));
         } else {
-          ui.showScriptOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showScriptOutput->setIcon(GetButtonIcon("vrightarrow"));
           ui.showScriptOutput->setIconSize(QSize(24, 24));
         }
       });
@@ -205,12 +189,10 @@ MountWidget::MountWidget(QProcess *process, const QString &remote,
         // ui.l_rclone->setVisible(checked);
 
         if (checked) {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vdownarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         } else {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         }
       });
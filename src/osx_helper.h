@@ -2,6 +2,7 @@
 
 #include "pch.h"
 
-QIcon osxGetIcon(const QString &extension);
+// image can be created outside GUI thread, QPixmap can't
+QImage osxGetIconImage(const QString &extension);
 void osxHideDockIcon();
 void osxShowDockIcon();
@@ -2,8 +2,8 @@
 #include <ApplicationServices/ApplicationServices.h>
 #include <Cocoa/Cocoa.h>
 
-QIcon osxGetIcon(const QString &extension) {
-  QIcon icon;
+QImage osxGetIconImage(const QString &extension) {
+  QImage icon;
   @autoreleasepool {
     NSImage *image =
         [[NSWorkspace sharedWorkspace] iconForFileType:extension.toNSString()];
@@ -12,7 +12,20 @@ QIcon osxGetIcon(const QString &extension) {
                                                 context:NULL
                                                   hints:nil];
     if (imageRef) {
-      icon = QtMac::fromCGImageRef(imageRef);
+      size_t width = CGImageGetWidth(imageRef);
+      size_t height = CGImageGetHeight(imageRef);
+      icon = QImage(int(width), int(height),
+                    QImage::Format_ARGB32_Premultiplied);
+      icon.fill(Qt::transparent);
+
+      // draw into image's own buffer
+      CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+      CGContextRef context = CGBitmapContextCreate(
+          icon.bits(), width, height, 8, icon.bytesPerLine(), colorSpace,
+          kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+      CGContextDrawImage(context, CGRectMake(0, 0, width, height), imageRef);
+      CGContextRelease(context);
+      CGColorSpaceRelease(colorSpace);
     }
   }
   return icon;
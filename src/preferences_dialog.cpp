@@ -58,8 +58,6 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent) {
   resize(0, 0);
   setMaximumHeight(this->height());
 
-  ui.rclone->setFocus(Qt::FocusReason::OtherFocusReason);
-
   QObject::connect(ui.rcloneBrowse, &QPushButton::clicked, this, [=]() {
     QString rclone = QFileDialog::getOpenFileName(
         this, "Select rclone executable", ui.rclone->text());
@@ -215,6 +213,51 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent) {
     }
   });
 
+  QObject::connect(ui.queueOrder,
+                   static_cast<void (QComboBox::*)(int)>(
+                       &QComboBox::currentIndexChanged),
+                   this, [=](int index) {
+                     ui.queueWindowEnd->setEnabled(index == 2);
+                   });
+
+  QObject::connect(ui.queueScript, &QLineEdit::textChanged, this, [=]() {
+    if (ui.queueScript->text().trimmed().isEmpty()) {
+      ui.queueScriptRun->setEnabled(false);
+      ui.queueScriptRun->setChecked(false);
+    } else {
+      ui.queueScriptRun->setEnabled(true);
+    }
+  });
+
+  QObject::connect(ui.transferOnScript, &QLineEdit::textChanged, this, [=]() {
+    if (ui.transferOnScript->text().trimmed().isEmpty()) {
+      ui.jobStartScriptRun->setEnabled(false);
+      ui.jobStartScriptRun->setChecked(false);
+    } else {
+      ui.jobStartScriptRun->setEnabled(true);
+    }
+  });
+
+  QObject::connect(ui.transferOffScript, &QLineEdit::textChanged, this, [=]() {
+    if (ui.transferOffScript->text().trimmed().isEmpty()) {
+      ui.jobLastFinishedScriptRun->setEnabled(false);
+      ui.jobLastFinishedScriptRun->setChecked(false);
+    } else {
+      ui.jobLastFinishedScriptRun->setEnabled(true);
+    }
+  });
+
+  loadSettings();
+}
+
+// dialog is kept and reused, current settings are loaded every time it is
+// shown
+void PreferencesDialog::loadSettings() {
+
+  auto settings = GetSettings();
+
+  ui.rclone->setFocus(Qt::FocusReason::OtherFocusReason);
+
   ui.rclone->setText(
       QDir::toNativeSeparators(settings->value("Settings/rclone").toString()));
   ui.rcloneConf->setText(QDir::toNativeSeparators(
@@ -255,6 +298,7 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent) {
         settings->value("Settings/closeToTray", false).toBool());
     ui.startMinimisedToTray->setChecked(
         settings->value("Settings/startMinimisedToTray", false).toBool());
+    ui.startMinimisedToTray->setDisabled(false);
 
     if (!(settings->value("Settings/closeToTray", false).toBool())) {
       ui.startMinimisedToTray->setChecked(false);
@@ -421,6 +465,25 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent) {
     }
   }
 
+  ui.queueSlots->setValue(settings->value("Settings/queueSlots", 1).toInt());
+  ui.queueRemoteCap->setValue(
+      settings->value("Settings/queueRemoteCap", 0).toInt());
+
+  QString queueOrder = settings->value("Settings/queueOrder").toString();
+  ui.queueOrder->setCurrentIndex(
+      queueOrder == "shortest" ? 1 : (queueOrder == "window" ? 2 : 0));
+  ui.queueWindowEnd->setTime(QTime::fromString(
+      settings->value("Settings/queueWindowEnd").toString(), "HH:mm"));
+  ui.queueWindowEnd->setEnabled(ui.queueOrder->currentIndex() == 2);
+
+  ui.schedulerCatchUp->setCurrentIndex(
+      settings->value("Settings/schedulerCatchUp").toString() == "once" ? 1
+                                                                        : 0);
+  ui.schedulerJitter->setValue(
+      settings->value("Settings/schedulerJitter", 0).toInt());
+  ui.schedulerRemoteCap->setValue(
+      settings->value("Settings/schedulerRemoteCap", 0).toInt());
+
   ui.queueScript->setText(QDir::toNativeSeparators(
       settings->value("Settings/queueScript").toString()));
   ui.transferOnScript->setText(QDir::toNativeSeparators(
@@ -450,33 +513,6 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent) {
   } else {
     ui.jobLastFinishedScriptRun->setEnabled(true);
   }
-
-  QObject::connect(ui.queueScript, &QLineEdit::textChanged, this, [=]() {
-    if (ui.queueScript->text().trimmed().isEmpty()) {
-      ui.queueScriptRun->setEnabled(false);
-      ui.queueScriptRun->setChecked(false);
-    } else {
-      ui.queueScriptRun->setEnabled(true);
-    }
-  });
-
-  QObject::connect(ui.transferOnScript, &QLineEdit::textChanged, this, [=]() {
-    if (ui.transferOnScript->text().trimmed().isEmpty()) {
-      ui.jobStartScriptRun->setEnabled(false);
-      ui.jobStartScriptRun->setChecked(false);
-    } else {
-      ui.jobStartScriptRun->setEnabled(true);
-    }
-  });
-
-  QObject::connect(ui.transferOffScript, &QLineEdit::textChanged, this, [=]() {
-    if (ui.transferOffScript->text().trimmed().isEmpty()) {
-      ui.jobLastFinishedScriptRun->setEnabled(false);
-      ui.jobLastFinishedScriptRun->setChecked(false);
-    } else {
-      ui.jobLastFinishedScriptRun->setEnabled(true);
-    }
-  });
 }
 
 PreferencesDialog::~PreferencesDialog() {}
@@ -694,6 +730,39 @@ QString PreferencesDialog::getPreemptiveLoadingLevel() const {
   }
 }
 
+int PreferencesDialog::getQueueSlots() const { return ui.queueSlots->value(); }
+
+int PreferencesDialog::getQueueRemoteCap() const {
+  return ui.queueRemoteCap->value();
+}
+
+QString PreferencesDialog::getQueueOrder() const {
+  switch (ui.queueOrder->currentIndex()) {
+  case 1:
+    return "shortest";
+  case 2:
+    return "window";
+  default:
+    return "manual";
+  }
+}
+
+QString PreferencesDialog::getQueueWindowEnd() const {
+  return ui.queueWindowEnd->time().toString("HH:mm");
+}
+
+QString PreferencesDialog::getSchedulerCatchUp() const {
+  return ui.schedulerCatchUp->currentIndex() == 1 ? "once" : "skip";
+}
+
+int PreferencesDialog::getSchedulerJitter() const {
+  return ui.schedulerJitter->value();
+}
+
+int PreferencesDialog::getSchedulerRemoteCap() const {
+  return ui.schedulerRemoteCap->value();
+}
+
 QString PreferencesDialog::getQueueScript() const {
   return ui.queueScript->text();
 }
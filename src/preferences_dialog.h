@@ -10,6 +10,8 @@ public:
   PreferencesDialog(QWidget *parent = nullptr);
   ~PreferencesDialog();
 
+  void loadSettings();
+
   QString getRclone() const;
   QString getRcloneConf() const;
   QString getStream() const;
@@ -54,6 +56,14 @@ public:
   bool getPreemptiveLoading() const;
   QString getPreemptiveLoadingLevel() const;
 
+  int getQueueSlots() const;
+  int getQueueRemoteCap() const;
+  QString getQueueOrder() const;
+  QString getQueueWindowEnd() const;
+  QString getSchedulerCatchUp() const;
+  int getSchedulerJitter() const;
+  int getSchedulerRemoteCap() const;
+
   QString getQueueScript() const;
   QString getTransferOnScript() const;
   QString getTransferOffScript() const;
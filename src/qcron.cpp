@@ -33,6 +33,7 @@
 
 #include <QDebug>
 #include <QTime>
+#include <QtAlgorithms>
 
 /******************************************************************************/
 
@@ -59,6 +60,40 @@ void QCron::_init() {
   _fields[3].setField(MONTH);
   _fields[4].setField(DOW);
   _fields[5].setField(YEAR);
+  _minutes = 0;
+  _hours = 0;
+  _days = 0;
+  _months = 0;
+  _weekdays = 0;
+  _years.reset();
+}
+
+/******************************************************************************/
+
+static quint64 compileField(const QCronField &field) {
+  quint64 bits = 0;
+  for (int value = field.getMin(); value <= field.getMax(); ++value) {
+    if (field.getRoot()->match(value)) {
+      bits |= quint64(1) << value;
+    }
+  }
+  return bits;
+}
+
+void QCron::_compile() {
+  _minutes = compileField(_fields[MINUTE]);
+  _hours = compileField(_fields[HOUR]);
+  _days = compileField(_fields[DOM]);
+  _months = compileField(_fields[MONTH]);
+  _weekdays = compileField(_fields[DOW]);
+
+  _years.reset();
+  for (int year = _fields[YEAR].getMin(); year <= _fields[YEAR].getMax();
+       ++year) {
+    if (_fields[YEAR].getRoot()->match(year)) {
+      _years.set(year);
+    }
+  }
 }
 
 /******************************************************************************/
@@ -96,6 +131,9 @@ void QCron::_parsePattern(QString &pattern) {
   } catch (QCronFieldException &e) {
     _setError(e.msg());
   }
+  if (_is_valid) {
+    _compile();
+  }
 }
 
 /******************************************************************************/
@@ -211,24 +249,98 @@ void QCron::chiche(QDateTime &dt, EField field) {
 
 /******************************************************************************/
 
+// lowest set bit not below from, -1 if there is none
+static int nextBit(quint64 bits, int from) {
+  if (from > 63) {
+    return -1;
+  }
+  bits >>= from;
+  if (bits == 0) {
+    return -1;
+  }
+  return from + int(qCountTrailingZeroBits(bits));
+}
+
+/******************************************************************************/
+
 QDateTime QCron::next(QDateTime dt) {
+  if (!_is_valid) {
+    return QDateTime();
+  }
+
   dt = dt.addSecs(60);
-  while (!match(dt)) {
-    // qDebug() << dt << "doesn't match";
-    for (int i = YEAR; i >= 0; --i) {
-      chiche(dt, (EField)i);
-      // qDebug() << dt << "after Chcihe";
-      if (!dt.isValid()) {
-        return dt;
+  QDate date = dt.date();
+  int hour = dt.time().hour();
+  int minute = dt.time().minute();
+
+  // go from the largest field down, when field does not match jump to its
+  // next matching value and start smaller fields from their minimum
+  while (date.isValid() && date.year() >= 1 &&
+         date.year() <= _fields[YEAR].getMax()) {
+    int year = date.year();
+    if (!_years.test(year)) {
+      while (year <= _fields[YEAR].getMax() && !_years.test(year)) {
+        ++year;
       }
-      while (!_fields[(EField)i].match(dt)) {
-        // qDebug() << dt << (EField)i << "doesn't match";
-        int dummy = 1;
-        _fields[(EField)i].applyOffset(dt, dummy);
+      date = QDate(year, 1, 1);
+      hour = 0;
+      minute = 0;
+      continue;
+    }
+    if (!((_months >> date.month()) & 1)) {
+      int month = nextBit(_months, date.month() + 1);
+      date = month == -1 ? QDate(year + 1, 1, 1) : QDate(year, month, 1);
+      hour = 0;
+      minute = 0;
+      continue;
+    }
+    if (!((_days >> date.day()) & 1) ||
+        !((_weekdays >> date.dayOfWeek()) & 1)) {
+      date = date.addDays(1);
+      hour = 0;
+      minute = 0;
+      continue;
+    }
+    int next_hour = nextBit(_hours, hour);
+    if (next_hour == -1) {
+      date = date.addDays(1);
+      hour = 0;
+      minute = 0;
+      continue;
+    }
+    if (next_hour != hour) {
+      hour = next_hour;
+      minute = 0;
+    }
+    int next_minute = nextBit(_minutes, minute);
+    if (next_minute == -1) {
+      minute = 0;
+      if (++hour > 23) {
+        date = date.addDays(1);
+        hour = 0;
       }
+      continue;
     }
+    dt.setDate(date);
+    dt.setTime(QTime(hour, next_minute, 0));
+    return dt;
   }
-  return dt;
+  return QDateTime();
+}
+
+/******************************************************************************/
+
+QList<QDateTime> QCron::next(QDateTime dt, int n, const QDateTime &until) {
+  QList<QDateTime> runs;
+  runs.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    dt = next(dt);
+    if (!dt.isValid() || (until.isValid() && dt > until)) {
+      break;
+    }
+    runs << dt;
+  }
+  return runs;
 }
 
 /******************************************************************************/
@@ -241,11 +353,15 @@ QDateTime QCron::next(int n) {
 /******************************************************************************/
 
 bool QCron::match(const QDateTime &dt) const {
-  bool does_match = true;
-  for (int i = 0; i < 6; ++i) {
-    does_match &= _fields[i].match(dt);
+  QDate date = dt.date();
+  QTime time = dt.time();
+  if (!_is_valid || !dt.isValid() || date.year() < 1 ||
+      date.year() > _fields[YEAR].getMax()) {
+    return false;
   }
-  return does_match;
+  return ((_minutes >> time.minute()) & 1) && ((_hours >> time.hour()) & 1) &&
+         ((_days >> date.day()) & 1) && ((_months >> date.month()) & 1) &&
+         ((_weekdays >> date.dayOfWeek()) & 1) && _years.test(date.year());
 }
 
 /******************************************************************************/
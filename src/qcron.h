@@ -32,6 +32,7 @@
 #include "qcronfield.h"
 #include <QDateTime>
 #include <QObject>
+#include <bitset>
 
 class QCron : public QObject {
   Q_OBJECT
@@ -52,6 +53,9 @@ public:
 
   QDateTime next(int n = 1);
   QDateTime next(QDateTime dt);
+  // up to n run times after dt, stops at until when it is valid
+  QList<QDateTime> next(QDateTime dt, int n,
+                        const QDateTime &until = QDateTime());
   void catchUp(QDateTime &dt, EField field, int value);
   bool match(const QDateTime &dt) const;
   void add(QDateTime &dt, EField field, int value);
@@ -66,7 +70,16 @@ private:
   QCronField _fields[6];
   QDateTime _beginning;
 
+  // fields compiled after parsing, bit n is set when value n matches
+  quint64 _minutes;
+  quint64 _hours;
+  quint64 _days;
+  quint64 _months;
+  quint64 _weekdays;
+  std::bitset<2100> _years;
+
   void _init();
+  void _compile();
   void _setError(const QString &error);
   void _parsePattern(QString &pattern);
   void _parseField(QString &field_str, EField field);
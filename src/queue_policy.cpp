@@ -0,0 +1,138 @@
+#include "queue_policy.h"
+#include "job_history.h"
+#include "job_options.h"
+#include "utils.h"
+
+QStringList GetPathRemotes(const QStringList &paths) {
+  QStringList remotes;
+  for (const QString &path : paths) {
+    int colon = path.indexOf(":");
+    if (colon > 1) {
+      remotes << path.left(colon);
+    }
+  }
+  remotes.removeDuplicates();
+  return remotes;
+}
+
+QStringList GetTaskRemotes(JobOptions *jo) {
+  return GetPathRemotes(QStringList() << jo->source << jo->dest);
+}
+
+bool IsRemoteBusy(const QStringList &remotes,
+                  const QHash<QString, int> &remotesUsage, int cap) {
+  if (cap <= 0) {
+    return false;
+  }
+  for (const QString &remote : remotes) {
+    if (remotesUsage.value(remote) >= cap) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int GetQueuePriorityRow(const QList<bool> &ahead) {
+  int row = 0;
+  while (row < ahead.count() && ahead.at(row)) {
+    row++;
+  }
+  return row;
+}
+
+qint64 GetQueueWindowSecs() {
+  auto settings = GetSettings();
+  QTime windowEnd = QTime::fromString(
+      settings->value("Settings/queueWindowEnd").toString(), "HH:mm");
+  if (!windowEnd.isValid()) {
+    return 0;
+  }
+
+  QDateTime now = QDateTime::currentDateTime();
+  QDateTime end(now.date(), windowEnd);
+  if (end <= now) {
+    end = end.addDays(1);
+  }
+  return now.secsTo(end);
+}
+
+int GetEarliestSlot(const QList<qint64> &slotsFree) {
+  int slot = 0;
+  for (int i = 1; i < slotsFree.count(); i++) {
+    if (slotsFree.at(i) < slotsFree.at(slot)) {
+      slot = i;
+    }
+  }
+  return slot;
+}
+
+// reorder waiting tasks using their durations from history
+// shortest - shortest first
+// window - longest tasks still fitting into maintenance window first
+// tasks without history keep their relative order at the end
+QList<int> GetQueueOrder(const QList<QueuedTask> &waiting,
+                         const QList<qint64> &runningRemaining) {
+
+  QList<int> ordered;
+  for (int i = 0; i < waiting.count(); i++) {
+    ordered << i;
+  }
+
+  auto settings = GetSettings();
+  QString order = settings->value("Settings/queueOrder").toString();
+
+  if ((order != "shortest" && order != "window") || waiting.count() < 2) {
+    return ordered;
+  }
+
+  QHash<QString, qint64> estimates =
+      JobHistory::getInstance()->getEstimatedDurations();
+
+  auto getDuration = [&](int i) -> qint64 {
+    return estimates.value(waiting.at(i).taskId, -1);
+  };
+
+  std::stable_sort(ordered.begin(), ordered.end(), [&](int a, int b) {
+    qint64 durationA = getDuration(a);
+    qint64 durationB = getDuration(b);
+    if (durationA < 0 || durationB < 0) {
+      return durationA >= 0 && durationB < 0;
+    }
+    return durationA < durationB;
+  });
+
+  if (order == "window") {
+    int slots = qMax(1, settings->value("Settings/queueSlots", 1).toInt());
+    qint64 windowSecs = GetQueueWindowSecs();
+
+    QList<qint64> slotsFree = runningRemaining;
+    while (slotsFree.count() < slots) {
+      slotsFree << 0;
+    }
+
+    // ordered is ascending so the last task which fits is the longest one
+    QList<int> fitted;
+    int longest = 0;
+    while (longest >= 0) {
+      int slot = GetEarliestSlot(slotsFree);
+      longest = -1;
+      for (int i = 0; i < ordered.count(); i++) {
+        qint64 duration = getDuration(ordered.at(i));
+        if (duration >= 0 && slotsFree.at(slot) + duration <= windowSecs) {
+          longest = i;
+        }
+      }
+      if (longest >= 0) {
+        slotsFree[slot] += getDuration(ordered.at(longest));
+        fitted << ordered.takeAt(longest);
+      }
+    }
+    ordered = fitted + ordered;
+  }
+
+  // scheduled runs pushed to the queue stay ahead of other tasks
+  std::stable_partition(ordered.begin(), ordered.end(),
+                        [&](int i) { return waiting.at(i).priority; });
+
+  return ordered;
+}
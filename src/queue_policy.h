@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pch.h"
+
+class JobOptions;
+
+// queue rules shared by MainWindow and headless instance so the same
+// queue.conf runs the same way in both
+
+// remotes used by paths - local paths (incl. Windows drives) are skipped
+QStringList GetPathRemotes(const QStringList &paths);
+QStringList GetTaskRemotes(JobOptions *jo);
+
+// true if any of remotes is used by at least cap running transfers
+bool IsRemoteBusy(const QStringList &remotes,
+                  const QHash<QString, int> &remotesUsage, int cap);
+
+// row behind running and priority tasks at the top of the queue, ahead has
+// one flag per queue row
+int GetQueuePriorityRow(const QList<bool> &ahead);
+
+// seconds from now till the end of maintenance window
+qint64 GetQueueWindowSecs();
+// slot which becomes free first
+int GetEarliestSlot(const QList<qint64> &slotsFree);
+
+struct QueuedTask {
+  QString taskId;
+  // scheduled run waiting for busy remote
+  bool priority = false;
+};
+
+// waiting tasks in order set by Settings/queueOrder as indexes into waiting,
+// runningRemaining are estimated seconds left for running queue tasks
+QList<int> GetQueueOrder(const QList<QueuedTask> &waiting,
+                         const QList<qint64> &runningRemaining);
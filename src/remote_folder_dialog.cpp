@@ -339,12 +339,7 @@ QStringList RemoteFolderDialog::getOptions() {
     for (auto line : ui.pte_textExtra->toPlainText().trimmed().split('\n')) {
       if (!line.isEmpty()) {
 
-        for (QString arg :
-             line.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
-          if (!arg.isEmpty()) {
-            args << arg.replace("\"", "");
-          }
-        }
+        args << SplitCommandLine(line);
       }
     }
   }
@@ -7,6 +7,7 @@
 #include "icon_cache.h"
 #include "item_model.h"
 #include "list_of_job_options.h"
+#include "local_listing.h"
 #include "mount_dialog.h"
 #include "progress_dialog.h"
 #include "remote_folder_dialog.h"
@@ -76,6 +77,7 @@ RemoteWidget::RemoteWidget(IconCache *iconCache, const QString &remote,
   QString buttonSize = settings->value("Settings/buttonSize").toString();
   QString iconsColour = settings->value("Settings/iconsColour").toString();
   settings->setValue("Settings/remoteMode", "main");
+  ReloadSettingsSnapshot();
   ui.tree->setAlternatingRowColors(
       settings->value("Settings/rowColors", false).toBool());
 
@@ -343,6 +345,7 @@ RemoteWidget::RemoteWidget(IconCache *iconCache, const QString &remote,
   ui.tree->header()->setSectionsMovable(false);
 
   model = new ItemModel(iconCache, remote, this);
+  model->setLocal(remoteType == "local");
   ui.tree->setModel(model);
   QTimer::singleShot(0, ui.tree, SLOT(setFocus()));
 
@@ -356,6 +359,30 @@ RemoteWidget::RemoteWidget(IconCache *iconCache, const QString &remote,
     ui.tree->resizeColumnToContents(2);
   });
 
+  // expanded local folders follow changes on disk
+  // subfolders expanded before their parent was collapsed are shown expanded
+  // again without own expanded signal
+  if (remoteType == "local") {
+    QObject::connect(ui.tree, &QTreeView::expanded, this,
+                     [=](const QModelIndex &index) {
+                       QList<QModelIndex> folders;
+                       folders << index;
+                       while (!folders.isEmpty()) {
+                         QModelIndex folder = folders.takeLast();
+                         model->watch(folder, true);
+                         for (int i = 0; i < model->rowCount(folder); i++) {
+                           QModelIndex child = model->index(i, 0, folder);
+                           if (ui.tree->isExpanded(child)) {
+                             folders << child;
+                           }
+                         }
+                       }
+                     });
+    QObject::connect(
+        ui.tree, &QTreeView::collapsed, this,
+        [=](const QModelIndex &index) { model->watch(index, false); });
+  }
+
   QObject::connect(ui.tree, &QAbstractItemView::clicked, this, [=]() {
     // not used now
 
@@ -1707,32 +1734,26 @@ RemoteWidget::RemoteWidget(IconCache *iconCache, const QString &remote,
     }
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)) && !(defined Q_OS_WIN)
-    QThread *thread = new QThread(this);
-    thread->start();
-
-    QObject *worker = new QObject();
-    worker->moveToThread(thread);
-
-    QTimer::singleShot(0, worker, [=]() {
-      QStorageInfo info;
-      info.refresh();
-
-      // QStorageInfo::mountedVolumes is slow :(
-      for (const auto &volume : info.mountedVolumes()) {
-        QString name = volume.name();
-        if (!name.isEmpty()) {
-          QString path = volume.rootPath();
-          QString item =
-              QString("%1 (%2)").arg(QDir::toNativeSeparators(path)).arg(name);
-          QTimer::singleShot(0, this,
-                             [=]() { model->rename(drives[path], item); });
+    // volume names are shared by all tabs, refreshed when a tab is opened
+    auto showVolumeNames = [=]() {
+      const QHash<QString, QString> &names =
+          LocalVolumes::getInstance()->getNames();
+      for (auto it = names.begin(); it != names.end(); ++it) {
+        if (drives.contains(it.key())) {
+          model->rename(drives[it.key()],
+                        QString("%1 (%2)")
+                            .arg(QDir::toNativeSeparators(it.key()))
+                            .arg(it.value()));
         }
       }
+    };
 
-      thread->quit();
-      thread->deleteLater();
-      worker->deleteLater();
-    });
+    LocalVolumes *volumes = LocalVolumes::getInstance();
+    QObject::connect(volumes, &LocalVolumes::ready, this, showVolumeNames);
+    volumes->request();
+    if (volumes->isReady()) {
+      showVolumeNames();
+    }
 #endif
 
     ui.tree->selectionModel()->selectionChanged(QItemSelection(),
@@ -1790,6 +1811,7 @@ QString setRemoteMode(int index, QString remoteType) {
       mode = "trash";
       break;
     }
+    ReloadSettingsSnapshot();
   }
 
   return mode;
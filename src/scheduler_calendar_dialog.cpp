@@ -0,0 +1,124 @@
+#include "scheduler_calendar_dialog.h"
+#include "job_history.h"
+#include "scheduler_widget.h"
+#include "utils.h"
+
+SchedulerCalendarDialog::SchedulerCalendarDialog(
+    const QList<SchedulerWidget *> &schedulers, QWidget *parent)
+    : QDialog(parent) {
+
+  ui.setupUi(this);
+
+  auto settings = GetSettings();
+
+  // set minimumWidth based on font size
+  int fontsize = 0;
+  fontsize = (settings->value("Settings/fontSize").toInt());
+  setMinimumWidth(minimumWidth() + (fontsize * 30));
+
+  QObject::connect(ui.buttonBox, &QDialogButtonBox::rejected, this,
+                   &QDialog::reject);
+
+  QDate today = QDate::currentDate();
+  QDateTime until(today.addDays(days), QTime(0, 0));
+
+  // every minute for whole period is the most any scheduler can run
+  const int maxRuns = days * 24 * 60;
+
+  QHash<QString, qint64> durations =
+      JobHistory::getInstance()->getEstimatedDurations();
+
+  // scheduler names and their runs started or still running in every hour
+  QVector<QMap<QString, int>> cells(days * 24);
+  int runsCount = 0;
+  int activeCount = 0;
+
+  // cell by wall clock day and hour, DST days still have 24 cells
+  auto getCell = [&](const QDateTime &dt) {
+    return int(today.daysTo(dt.date())) * 24 + dt.time().hour();
+  };
+
+  for (SchedulerWidget *scheduler : schedulers) {
+    QList<QDateTime> runs = scheduler->getNextRuns(until, maxRuns);
+    if (runs.isEmpty()) {
+      continue;
+    }
+    activeCount++;
+    runsCount += runs.count();
+
+    qint64 duration =
+        qMax(qint64(1), durations.value(scheduler->getSchedulerTaskId()));
+    QString name = scheduler->getSchedulerName();
+
+    for (const QDateTime &run : runs) {
+      QDateTime end = run.addSecs(duration - 1);
+      int first = getCell(run);
+      int last = qMin(getCell(end), days * 24 - 1);
+      for (int cell = qMax(first, 0); cell <= last; cell++) {
+        cells[cell][name]++;
+      }
+    }
+  }
+
+  ui.table->setRowCount(days);
+  ui.table->setColumnCount(24);
+
+  QStringList hours;
+  for (int hour = 0; hour < 24; hour++) {
+    hours << QString("%1").arg(hour, 2, 10, QChar('0'));
+  }
+  ui.table->setHorizontalHeaderLabels(hours);
+
+  QStringList dates;
+  for (int day = 0; day < days; day++) {
+    dates << QLocale(QLocale::English)
+                 .toString(today.addDays(day), "ddd, dd/MMM");
+  }
+  ui.table->setVerticalHeaderLabels(dates);
+
+  int maxOverlap = 1;
+  for (const QMap<QString, int> &cell : cells) {
+    maxOverlap = qMax(maxOverlap, cell.count());
+  }
+
+  int overlapHours = 0;
+  for (int i = 0; i < cells.count(); i++) {
+    const QMap<QString, int> &cell = cells.at(i);
+    auto item = new QTableWidgetItem();
+    item->setTextAlignment(Qt::AlignCenter);
+
+    if (!cell.isEmpty()) {
+      if (cell.count() > 1) {
+        overlapHours++;
+      }
+      item->setText(QString::number(cell.count()));
+
+      // from pale yellow for single task to red for the busiest hour
+      int heat = 200 * (cell.count() - 1) / qMax(1, maxOverlap - 1);
+      item->setBackground(QColor(255, 230 - heat, 150 - heat * 3 / 4));
+      item->setForeground(Qt::black);
+
+      QStringList tip;
+      for (auto it = cell.constBegin(); it != cell.constEnd(); ++it) {
+        tip << (it.value() > 1
+                    ? QString("%1 (%2 runs)").arg(it.key()).arg(it.value())
+                    : it.key());
+      }
+      item->setToolTip(tip.join("\n"));
+    }
+    ui.table->setItem(i / 24, i % 24, item);
+  }
+
+  ui.table->resizeColumnsToContents();
+
+  ui.summary->setText(
+      QString("%1 runs of %2 active schedulers in next %3 days, %4 hours "
+              "with overlapping tasks.\nTasks last as long as their average "
+              "run in history (or under a minute without history).")
+          .arg(runsCount)
+          .arg(activeCount)
+          .arg(days)
+          .arg(overlapHours));
+}
+
+SchedulerCalendarDialog::~SchedulerCalendarDialog() {}
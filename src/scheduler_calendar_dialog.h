@@ -0,0 +1,22 @@
+#pragma once
+
+#include "pch.h"
+#include "ui_scheduler_calendar_dialog.h"
+
+class SchedulerWidget;
+
+// runs of all active schedulers in the coming days as day x hour heat map,
+// runs are stretched over their expected duration so overlaps stand out
+class SchedulerCalendarDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  SchedulerCalendarDialog(const QList<SchedulerWidget *> &schedulers,
+                          QWidget *parent = nullptr);
+  ~SchedulerCalendarDialog();
+
+private:
+  Ui::SchedulerCalendarDialog ui;
+
+  static const int days = 30;
+};
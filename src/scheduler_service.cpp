@@ -0,0 +1,105 @@
+#include "scheduler_service.h"
+#include "utils.h"
+
+SchedulerService *SchedulerService::Service = nullptr;
+const qint64 SchedulerService::graceMs;
+const qint64 SchedulerService::maxSleepMs;
+
+SchedulerService::SchedulerService() {
+  mTimer.setSingleShot(true);
+  mTimer.setTimerType(Qt::PreciseTimer);
+  QObject::connect(&mTimer, &QTimer::timeout, this, [=]() { wakeUp(); });
+}
+
+SchedulerService *SchedulerService::getInstance() {
+  if (Service == nullptr) {
+    Service = new SchedulerService();
+  }
+  return Service;
+}
+
+void SchedulerService::schedule(ScheduledRun *scheduler,
+                                const QDateTime &nextRun) {
+
+  mGenerations.insert(scheduler, ++mGeneration);
+  mQueue.push({nextRun.toMSecsSinceEpoch(), mGeneration, scheduler});
+
+  compact();
+  arm();
+}
+
+void SchedulerService::unschedule(ScheduledRun *scheduler) {
+  mGenerations.remove(scheduler);
+  compact();
+}
+
+qint64 SchedulerService::getJitter(const QString &schedulerId) {
+  int jitter =
+      GetSettingsSnapshot()->value("Settings/schedulerJitter").toInt();
+  return jitter > 0 ? qHash(schedulerId) % (uint(jitter) * 1000) : 0;
+}
+
+void SchedulerService::wakeUp() {
+
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  // missed runs (e.g. sleep/hibernation) are either skipped or run once
+  bool catchUp =
+      GetSettingsSnapshot()->value("Settings/schedulerCatchUp").toString() ==
+      "once";
+
+  while (!mQueue.empty() && mQueue.top().due <= now) {
+    Entry entry = mQueue.top();
+    mQueue.pop();
+
+    auto it = mGenerations.find(entry.scheduler);
+    if (it == mGenerations.end() || it.value() != entry.generation) {
+      continue;
+    }
+    mGenerations.erase(it);
+
+    bool missed = now - entry.due > graceMs;
+    // scheduler re-arms itself with run time after now
+    entry.scheduler->runSchedule(!missed || catchUp);
+  }
+
+  arm();
+}
+
+void SchedulerService::arm() {
+
+  // drop stale entries so timer is not woken up for nothing
+  while (!mQueue.empty()) {
+    const Entry &top = mQueue.top();
+    if (mGenerations.value(top.scheduler) == top.generation) {
+      break;
+    }
+    mQueue.pop();
+  }
+
+  if (mQueue.empty()) {
+    mTimer.stop();
+    return;
+  }
+
+  qint64 wait = mQueue.top().due - QDateTime::currentMSecsSinceEpoch();
+  mTimer.start(int(qBound(qint64(0), wait, maxSleepMs)));
+}
+
+void SchedulerService::compact() {
+
+  if (mQueue.size() <= size_t(2 * mGenerations.size() + 64)) {
+    return;
+  }
+
+  std::vector<Entry> live;
+  live.reserve(size_t(mGenerations.size()));
+  while (!mQueue.empty()) {
+    const Entry &entry = mQueue.top();
+    if (mGenerations.value(entry.scheduler) == entry.generation) {
+      live.push_back(entry);
+    }
+    mQueue.pop();
+  }
+  mQueue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>(
+      std::greater<Entry>(), std::move(live));
+}
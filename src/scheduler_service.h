@@ -0,0 +1,62 @@
+#pragma once
+
+#include "pch.h"
+#include <queue>
+#include <vector>
+
+// anything SchedulerService can start
+class ScheduledRun {
+public:
+  virtual ~ScheduledRun() = default;
+  // called at next run time, run is false for missed runs which should be
+  // skipped
+  virtual void runSchedule(bool run) = 0;
+};
+
+// one timer for all schedulers - next run times are kept in min-heap and
+// timer sleeps until the earliest one
+class SchedulerService : public QObject {
+  Q_OBJECT
+
+protected:
+  ~SchedulerService() = default;
+  SchedulerService();
+
+public:
+  static SchedulerService *getInstance();
+
+  // (re)arm scheduler, replaces its previous run time
+  void schedule(ScheduledRun *scheduler, const QDateTime &nextRun);
+  void unschedule(ScheduledRun *scheduler);
+
+  // stable delay in ms spreading runs of schedulers planned for the same
+  // minute, up to Settings/schedulerJitter seconds
+  static qint64 getJitter(const QString &schedulerId);
+
+private:
+  static SchedulerService *Service;
+  // run is on time if started within this delay
+  static const qint64 graceMs = 60000;
+  // timers do not follow wall clock changes and on some platforms stop
+  // during sleep so never wait longer than this before checking the clock
+  static const qint64 maxSleepMs = 600000;
+
+  struct Entry {
+    qint64 due;
+    quint64 generation;
+    ScheduledRun *scheduler;
+
+    bool operator>(const Entry &other) const { return due > other.due; }
+  };
+
+  // rescheduled or removed entries stay in heap and are dropped when
+  // their generation no longer matches
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> mQueue;
+  QHash<ScheduledRun *, quint64> mGenerations;
+  quint64 mGeneration = 0;
+  QTimer mTimer;
+
+  void wakeUp();
+  void arm();
+  void compact();
+};
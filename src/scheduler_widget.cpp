@@ -1,5 +1,6 @@
 #include "scheduler_widget.h"
 #include "qcron.h"
+#include "scheduler_service.h"
 #include "utils.h"
 
 SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
@@ -10,7 +11,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
   mTaskName = taskName;
 
   ui.setupUi(this);
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
 
   QString newInfo = "Scheduled task: " + taskName;
 
@@ -22,7 +23,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
 
   if (args.at(0) == "NewScheduler") {
     // new scheduler - apply defaults
-    mNextRun = nextRun();
+    updateNextRun();
 
     applySettingsToScreen();
     updateInfoFields();
@@ -46,7 +47,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
       mLastRunStatus = "unknown";
     }
 
-    mNextRun = nextRun();
+    updateNextRun();
     applySettingsToScreen();
     updateInfoFields();
   }
@@ -57,50 +58,34 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
 
   QString mIconsColour = settings->value("Settings/iconsColour").toString();
 
-  QString img_add = "";
-
-  if (mIconsColour == "white") {
-    img_add = "_inv";
-  }
-
-  ui.showDetails->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
   ui.showDetails->setIconSize(QSize(24, 24));
 
   ui.details->setVisible(false);
 
-  ui.runTask->setIcon(
-      QIcon(":media/images/qbutton_icons/run" + img_add + ".png"));
+  ui.runTask->setIcon(GetButtonIcon("run"));
   ui.runTask->setIconSize(QSize(24, 24));
 
-  ui.stopTask->setIcon(
-      QIcon(":media/images/qbutton_icons/stop" + img_add + ".png"));
+  ui.stopTask->setIcon(GetButtonIcon("stop"));
   ui.stopTask->setIconSize(QSize(24, 24));
 
-  ui.editTask->setIcon(
-      QIcon(":media/images/qbutton_icons/edit" + img_add + ".png"));
+  ui.editTask->setIcon(GetButtonIcon("edit"));
   ui.editTask->setIconSize(QSize(24, 24));
 
-  ui.cancel->setIcon(
-      QIcon(":media/images/qbutton_icons/cancel" + img_add + ".png"));
+  ui.cancel->setIcon(GetButtonIcon("cancel"));
   ui.cancel->setIconSize(QSize(24, 24));
 
-  ui.pause->setIcon(
-      QIcon(":media/images/qbutton_icons/pause" + img_add + ".png"));
+  ui.pause->setIcon(GetButtonIcon("pause"));
   ui.pause->setIconSize(QSize(24, 24));
 
-  ui.start->setIcon(
-      QIcon(":media/images/qbutton_icons/run" + img_add + ".png"));
+  ui.start->setIcon(GetButtonIcon("run"));
   ui.start->setIconSize(QSize(24, 24));
 
   ui.saveStatus->hide();
 
-  // start timer based scheduler
-  QTimer::singleShot(5000, Qt::VeryCoarseTimer, this, SLOT(checkSchedule()));
-
   QObject::connect(ui.start, &QPushButton::clicked, this, [=]() {
     mSchedulerStatus = "activated";
-    mNextRun = nextRun();
+    updateNextRun();
     updateInfoFields();
     emit save();
   });
@@ -155,8 +140,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
       ui.showDetails, &QToolButton::toggled, this, [=](bool checked) {
         ui.details->setVisible(checked);
         if (checked) {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vdownarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
 
           if (mDailyState) {
@@ -167,8 +151,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
             ui.tabWidget->setCurrentIndex(1);
           }
         } else {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         }
       });
@@ -442,7 +425,7 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
     // save task
     applyScreenToSettings();
     updateInfoFields();
-    mNextRun = nextRun();
+    updateNextRun();
     emit save();
     applySettingsToScreen();
     updateInfoFields();
@@ -465,48 +448,36 @@ SchedulerWidget::SchedulerWidget(const QString &taskId, const QString &taskName,
   });
 }
 
-SchedulerWidget::~SchedulerWidget() {}
-
-void SchedulerWidget::checkSchedule(void) {
-
-  QDateTime nowDateTime = QDateTime::currentDateTime();
-  qint64 diff = mNextRun.secsTo(nowDateTime);
-
-  if (diff >= 0 && diff < 60) {
+SchedulerWidget::~SchedulerWidget() {
+  SchedulerService::getInstance()->unschedule(this);
+}
 
-    mNextRun = nextRun();
-    updateInfoFields();
+void SchedulerWidget::runSchedule(bool run) {
 
-    if (!mGlobalStop && (mSchedulerStatus == "activated") && !mTaskRunning) {
-      mRequestId = QUuid::createUuid().toString();
-      mManualStart = false;
-      emit runTask();
-    }
-  }
+  updateNextRun(true);
+  updateInfoFields();
 
-  // reschedule if missed becasue e.g. sleep/hibernation
-  if (diff > 60) {
-    mNextRun = nextRun();
-    updateInfoFields();
+  if (run && !mGlobalStop && (mSchedulerStatus == "activated") &&
+      !mTaskRunning) {
+    mRequestId = QUuid::createUuid().toString();
+    mManualStart = false;
+    emit runTask();
   }
+}
 
-  // set next check at full minute
-  QDateTime dt_start = QDateTime::currentDateTime();
-  QTime time = dt_start.time();
-
-  time.setHMS(time.hour(), time.minute() + 1, 0, 0);
-  dt_start.setTime(time);
-
-  diff = QDateTime::currentDateTime().msecsTo(dt_start);
-
-  if (diff < 0) {
-    diff = 0;
-  };
+void SchedulerWidget::updateNextRun(bool fromLastRun) {
+  qint64 jitter = SchedulerService::getJitter(mSchedulerId);
+  QDateTime after = QDateTime::currentDateTime();
 
-  QTimer::singleShot(diff + 1000, Qt::VeryCoarseTimer, this,
-                     SLOT(checkSchedule()));
+  // run is started jitter after its time, next one is counted from that
+  // time so that no run is dropped when jitter is longer than the period,
+  // after missed runs counted from now so it is not due already
+  if (fromLastRun && mNextRun.isValid()) {
+    after = qMax(mNextRun, after.addMSecs(-jitter));
+  }
 
-  return;
+  mNextRun = nextRun(after);
+  SchedulerService::getInstance()->schedule(this, mNextRun.addMSecs(jitter));
 }
 
 void SchedulerWidget::applyScreenToSettings() {
@@ -896,26 +867,25 @@ void SchedulerWidget::updateTaskStatus(const QString requestID,
   }
 }
 
-QDateTime SchedulerWidget::nextRun() {
+QDateTime SchedulerWidget::nextRun(const QDateTime &after) {
 
-  QDateTime nowDateTime = QDateTime::currentDateTime();
+  QDateTime nowDateTime = after;
 
   if (mCronState) {
-    QString cronExp = enhanceCron(mCron.trimmed()) + " *";
-    QCron cron(cronExp);
-
-    QDateTime next = cron.next(nowDateTime);
-    QTime time = next.time();
+    QDateTime next = compiledCron()->next(nowDateTime);
+    if (next.isValid()) {
+      QTime time = next.time();
 
-    time.setHMS(time.hour(), time.minute(), 0, 0);
-    next.setTime(time);
+      time.setHMS(time.hour(), time.minute(), 0, 0);
+      next.setTime(time);
 
-    return (next);
+      return (next);
+    }
   }
 
   if (mDailyState) {
 
-    QDate date = QDate::currentDate();
+    QDate date = nowDateTime.date();
     QTime time = QTime(mDailyHour.toInt(), mDailyMinute.toInt(), 0, 0);
     QDateTime dt = QDateTime(date, time);
     qint64 diff;
@@ -971,6 +941,71 @@ QDateTime SchedulerWidget::nextRun() {
                                 "ddd, dd/MMM/yyyy HH:mm:ss t"));
 }
 
+// pattern is compiled only when changed
+QCron *SchedulerWidget::compiledCron() {
+
+  QString cronExp = enhanceCron(mCron.trimmed()) + " *";
+
+  if (!mCompiledCron || mCompiledCronExp != cronExp) {
+    mCompiledCronExp = cronExp;
+    mCompiledCron.reset(new QCron(cronExp));
+  }
+  return mCompiledCron.get();
+}
+
+bool SchedulerWidget::isDailyRunDay(int dayOfWeek) const {
+  switch (dayOfWeek) {
+  case 1:
+    return mDailyMon;
+  case 2:
+    return mDailyTue;
+  case 3:
+    return mDailyWed;
+  case 4:
+    return mDailyThu;
+  case 5:
+    return mDailyFri;
+  case 6:
+    return mDailySat;
+  case 7:
+    return mDailySun;
+  default:
+    return false;
+  }
+}
+
+QList<QDateTime> SchedulerWidget::getNextRuns(const QDateTime &until,
+                                              int max) {
+
+  QList<QDateTime> runs;
+
+  if (mGlobalStop || mSchedulerStatus != "activated") {
+    return runs;
+  }
+
+  QDateTime nowDateTime = QDateTime::currentDateTime();
+
+  if (mCronState) {
+    return compiledCron()->next(nowDateTime, max, until);
+  }
+
+  if (mDailyState) {
+    QTime time = QTime(mDailyHour.toInt(), mDailyMinute.toInt(), 0, 0);
+
+    for (QDate date = nowDateTime.date();
+         date <= until.date() && runs.count() < max; date = date.addDays(1)) {
+      QDateTime dt = QDateTime(date, time);
+      if (isDailyRunDay(date.dayOfWeek()) && dt > nowDateTime && dt <= until) {
+        runs << dt;
+      }
+    }
+  }
+
+  return runs;
+}
+
+QString SchedulerWidget::getSchedulerName() { return mSchedulerName; }
+
 void SchedulerWidget::updateInfoFields(void) {
 
   if (!mGlobalStop) {
@@ -3,9 +3,12 @@
 #include "hours_spinbox.h"
 #include "minutes_spinbox.h"
 #include "pch.h"
+#include "scheduler_service.h"
 #include "ui_scheduler_widget.h"
 
-class SchedulerWidget : public QWidget {
+class QCron;
+
+class SchedulerWidget : public QWidget, public ScheduledRun {
   Q_OBJECT
 
 public:
@@ -26,10 +29,17 @@ public:
   QString getSchedulerTaskId();
   QString getSchedulerRequestId();
   int getExecutionMode();
+  QString getSchedulerName();
+  // run times until given time (at most max), empty when not active
+  QList<QDateTime> getNextRuns(const QDateTime &until, int max);
   void updateTaskName(const QString newTaskName);
   void updateTaskStatus(const QString requestID, const QString taskStatus);
   void stopScheduler();
   void startScheduler();
+  void runSchedule(bool run) override;
+
+  // day and month names replaced by numbers QCron understands
+  static QString enhanceCron(QString cron);
 
 public slots:
   //  void cancel();
@@ -51,9 +61,12 @@ private:
   void applyScreenToSettings();
   void updateInfoFields();
 
-  QString enhanceCron(QString cron);
 
-  QDateTime nextRun();
+  // first run after given time
+  QDateTime nextRun(const QDateTime &after);
+  void updateNextRun(bool fromLastRun = false);
+  QCron *compiledCron();
+  bool isDailyRunDay(int dayOfWeek) const;
 
   // list of scheduler parameters to be persistent in file
   QString mSchedulerStatus = "paused"; // activated, paused
@@ -90,7 +103,6 @@ private:
   bool mGlobalStop = false;
   QDateTime mNextRun;
 
-private slots:
-
-  void checkSchedule(void);
+  std::unique_ptr<QCron> mCompiledCron;
+  QString mCompiledCronExp;
 };
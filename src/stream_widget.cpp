@@ -11,7 +11,7 @@ StreamWidget::StreamWidget(QProcess *rclone, QProcess *player,
 
   QString remoteTrimmed;
 
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
   mArgs.append(QDir::toNativeSeparators(GetRclone()));
   mArgs.append(args);
   mArgs.append(" | ");
@@ -46,7 +46,6 @@ StreamWidget::StreamWidget(QProcess *rclone, QProcess *player,
 #endif
 
   QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-  QFontMetrics fm(font);
 
   font.setPointSize(font.pointSize() + fontsize);
 
@@ -55,25 +54,16 @@ StreamWidget::StreamWidget(QProcess *rclone, QProcess *player,
 
   QString iconsColour = settings->value("Settings/iconsColour").toString();
 
-  QString img_add = "";
-
-  if (iconsColour == "white") {
-    img_add = "_inv";
-  }
-
-  ui.showDetails->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
   ui.showDetails->setIconSize(QSize(24, 24));
 
-  ui.showOutput->setIcon(
-      QIcon(":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+  ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
   ui.showOutput->setIconSize(QSize(24, 24));
 
   ui.cancel->setToolTip("Stop streaming");
   ui.cancel->setStatusTip("Stop streaming");
 
-  ui.copy->setIcon(
-      QIcon(":media/images/qbutton_icons/copy" + img_add + ".png"));
+  ui.copy->setIcon(GetButtonIcon("copy"));
   ui.copy->setIconSize(QSize(24, 24));
 
   QObject::connect(ui.copy, &QToolButton::clicked, this, [=]() {
@@ -85,12 +75,10 @@ StreamWidget::StreamWidget(QProcess *rclone, QProcess *player,
       ui.showDetails, &QToolButton::toggled, this, [=](bool checked) {
         ui.details->setVisible(checked);
         if (checked) {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vdownarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         } else {
-          ui.showDetails->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showDetails->setIcon(GetButtonIcon("vrightarrow"));
           ui.showDetails->setIconSize(QSize(24, 24));
         }
       });
@@ -99,18 +87,15 @@ StreamWidget::StreamWidget(QProcess *rclone, QProcess *player,
       ui.showOutput, &QToolButton::toggled, this, [=](bool checked) {
         ui.output->setVisible(checked);
         if (checked) {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vdownarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vdownarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         } else {
-          ui.showOutput->setIcon(QIcon(
-              ":media/images/qbutton_icons/vrightarrow" + img_add + ".png"));
+          ui.showOutput->setIcon(GetButtonIcon("vrightarrow"));
           ui.showOutput->setIconSize(QSize(24, 24));
         }
       });
 
-  ui.cancel->setIcon(
-      QIcon(":media/images/qbutton_icons/cancel" + img_add + ".png"));
+  ui.cancel->setIcon(GetButtonIcon("cancel"));
   ui.cancel->setIconSize(QSize(24, 24));
 
   QObject::connect(ui.cancel, &QToolButton::clicked, this, [=]() {
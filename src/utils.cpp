@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "global.h"
 
 static QString gRclone;
 static QString gRcloneConf;
@@ -75,7 +76,7 @@ static QString GetIniFilename() {
 #endif
 }
 
-bool IsPortableMode() {
+static bool CheckPortableMode() {
   QString ini = GetIniFilename();
   QString xdg_config_home = qgetenv("XDG_CONFIG_HOME");
   //  qDebug() << QString("utils.cpp $XDG_CONFIG_HOME: " + xdg_config_home);
@@ -103,7 +104,22 @@ bool IsPortableMode() {
   //  return QFileInfo(ini).exists();
 }
 
+// portable mode is decided at start, no need to check ini file every time
+bool IsPortableMode() {
+  static const bool portableMode = CheckPortableMode();
+  return portableMode;
+}
+
+static QString gConfigDirOverride;
+
+void SetConfigDirOverride(const QString &dir) { gConfigDirOverride = dir; }
+
 std::unique_ptr<QSettings> GetSettings() {
+  if (!gConfigDirOverride.isEmpty()) {
+    return std::unique_ptr<QSettings>(
+        new QSettings(QDir(gConfigDirOverride).filePath("rclone-browser.ini"),
+                      QSettings::IniFormat));
+  }
   if (IsPortableMode()) {
     return std::unique_ptr<QSettings>(
         new QSettings(GetIniFilename(), QSettings::IniFormat));
@@ -111,6 +127,57 @@ std::unique_ptr<QSettings> GetSettings() {
   return std::unique_ptr<QSettings>(new QSettings);
 }
 
+static std::shared_ptr<const SettingsSnapshot> gSettingsSnapshot;
+static QMutex gSettingsSnapshotMutex;
+static QFileSystemWatcher *gSettingsWatcher = nullptr;
+// tokenized options settings, cleared together with the snapshot
+static QHash<QString, QStringList> gOptionsLists;
+
+std::shared_ptr<const SettingsSnapshot> GetSettingsSnapshot() {
+  QMutexLocker locker(&gSettingsSnapshotMutex);
+
+  if (gSettingsSnapshot) {
+    return gSettingsSnapshot;
+  }
+
+  auto settings = GetSettings();
+  auto snapshot = std::make_shared<SettingsSnapshot>();
+  for (const QString &key : settings->allKeys()) {
+    snapshot->insert(key, settings->value(key));
+  }
+  gSettingsSnapshot = snapshot;
+
+  // settings file can be changed outside of Rclone Browser
+  // (not available for Windows registry)
+  if (gSettingsWatcher == nullptr && qApp != nullptr &&
+      QThread::currentThread() == qApp->thread()) {
+    gSettingsWatcher = new QFileSystemWatcher(qApp);
+    QObject::connect(gSettingsWatcher, &QFileSystemWatcher::fileChanged,
+                     gSettingsWatcher, [](const QString &path) {
+                       ReloadSettingsSnapshot();
+                       // file replaced by editor has to be watched again
+                       if (!gSettingsWatcher->files().contains(path) &&
+                           QFileInfo::exists(path)) {
+                         gSettingsWatcher->addPath(path);
+                       }
+                     });
+  }
+  if (gSettingsWatcher != nullptr &&
+      !gSettingsWatcher->files().contains(settings->fileName()) &&
+      QFileInfo::exists(settings->fileName())) {
+    gSettingsWatcher->addPath(settings->fileName());
+  }
+
+  return gSettingsSnapshot;
+}
+
+void ReloadSettingsSnapshot() {
+  QMutexLocker locker(&gSettingsSnapshotMutex);
+  // rebuilt on next use
+  gSettingsSnapshot.reset();
+  gOptionsLists.clear();
+}
+
 void ReadSettings(QSettings *settings, QObject *widget) {
   QString name = widget->objectName();
 
@@ -272,7 +339,7 @@ void SetRclonePassword(const QString &rclonePassword) {
 }
 
 QStringList GetRemoteModeRcloneOptions() {
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
   QString googleDriveMode =
       settings->value("Settings/remoteMode", "main").toString();
 
@@ -288,29 +355,83 @@ QStringList GetRemoteModeRcloneOptions() {
 }
 
 QStringList GetDefaultOptionsList(const QString &settingsOptions) {
-  auto settings = GetSettings();
-  QString defaultOptions =
-      settings->value("Settings/" + settingsOptions).toString();
-  //      settings->value("Settings/defaultRcloneOptions").toString();
-  QStringList defaultOptionsList;
-
-  if (!defaultOptions.isEmpty()) {
-    // split on spaces but not if inside quotes e.g. --option-1 --option-2="arg1
-    // arg2" --option-3 arg3 should generate "--option-1" "--option-2=\"arg1
-    // arg2\"" "--option-3" "arg3"
-    for (QString arg :
-         defaultOptions.split(QRegExp(" (?=[^\"]*(\"[^\"]*\"[^\"]*)*$)"))) {
+  {
+    QMutexLocker locker(&gSettingsSnapshotMutex);
+    auto it = gOptionsLists.constFind(settingsOptions);
+    if (it != gOptionsLists.constEnd()) {
+      return it.value();
+    }
+  }
+
+  auto settings = GetSettingsSnapshot();
+  QStringList defaultOptionsList = SplitCommandLine(
+      settings->value("Settings/" + settingsOptions).toString());
+
+  QMutexLocker locker(&gSettingsSnapshotMutex);
+  // don't cache options parsed from snapshot which was reloaded meanwhile
+  if (gSettingsSnapshot == settings) {
+    gOptionsLists.insert(settingsOptions, defaultOptionsList);
+  }
+  return defaultOptionsList;
+}
+
+// split on spaces but not if inside quotes e.g. --option-1 --option-2="arg1
+// arg2" --option-3 arg3 should generate "--option-1" "--option-2=arg1 arg2"
+// "--option-3" "arg3"
+// same rules as the former regular expression split so stored option
+// strings keep their meaning: space is inside quotes when odd number of '"'
+// follows it, all '"' are removed and empty parts are skipped
+QStringList SplitCommandLine(const QString &line) {
+  QStringList args;
+  int quotesAfter = line.count('"');
+  int start = 0;
+
+  for (int i = 0; i <= line.size(); i++) {
+    if (i == line.size() || (line.at(i) == ' ' && quotesAfter % 2 == 0)) {
+      QString arg = line.mid(start, i - start);
       if (!arg.isEmpty()) {
-        defaultOptionsList << arg.replace("\"", "");
+        args << arg.remove('"');
       }
+      start = i + 1;
+    } else if (line.at(i) == '"') {
+      quotesAfter--;
     }
   }
 
-  return defaultOptionsList;
+  return args;
+}
+
+QIcon GetButtonIcon(const QString &name) {
+  static QHash<QString, QIcon> buttonIcons;
+
+  QString img_add = "";
+  if (GetSettingsSnapshot()->value("Settings/iconsColour").toString() ==
+      "white") {
+    img_add = "_inv";
+  }
+
+  // icons used by every transfer, mount and scheduler widget are created
+  // together with the first one
+  if (!buttonIcons.contains("vrightarrow" + img_add)) {
+    for (const QString &icon : {"vrightarrow", "vdownarrow", "cancel", "copy",
+                                "pause", "run", "stop", "edit"}) {
+      buttonIcons.insert(
+          icon + img_add,
+          QIcon(":media/images/qbutton_icons/" + icon + img_add + ".png"));
+    }
+  }
+
+  auto it = buttonIcons.constFind(name + img_add);
+  if (it != buttonIcons.constEnd()) {
+    return it.value();
+  }
+  QIcon icon(":media/images/qbutton_icons/" + name + img_add + ".png");
+  buttonIcons.insert(name + img_add, icon);
+  return icon;
 }
 
 QStringList GetShowHidden() {
-  auto settings = GetSettings();
+  auto settings = GetSettingsSnapshot();
   bool showHidden = settings->value("Settings/showHidden", true).toBool();
   QStringList showHiddenOption;
   if (!showHidden) {
@@ -326,7 +447,9 @@ QDir GetConfigDir() {
 
   QDir outputDir;
 
-  if (IsPortableMode()) {
+  if (!gConfigDirOverride.isEmpty()) {
+    outputDir = QDir(gConfigDirOverride);
+  } else if (IsPortableMode()) {
     // in portable mode tasks' file will be saved in the same folder as
     // excecutable
 #ifdef Q_OS_MACOS
@@ -365,6 +488,186 @@ QDir GetConfigDir() {
   return outputDir;
 }
 
+// config file rclone uses - set one or the first found in rclone's default
+// locations
+static QString GetRcloneConfPath() {
+
+  QStringList rcloneConf = GetRcloneConf();
+  if (!rcloneConf.isEmpty()) {
+    return rcloneConf.at(1);
+  }
+
+  QString envConf = qgetenv("RCLONE_CONFIG");
+  if (!envConf.isEmpty()) {
+    return envConf;
+  }
+
+  QStringList candidates;
+#ifdef Q_OS_WIN
+  candidates << QString(qgetenv("APPDATA")) + "/rclone/rclone.conf";
+#endif
+  QString xdg_config_home = qgetenv("XDG_CONFIG_HOME");
+  if (!xdg_config_home.isEmpty()) {
+    candidates << xdg_config_home + "/rclone/rclone.conf";
+  }
+  candidates << QDir::homePath() + "/.config/rclone/rclone.conf"
+             << QDir::homePath() + "/.rclone.conf";
+
+  for (const QString &candidate : candidates) {
+    if (QFileInfo::exists(candidate)) {
+      return candidate;
+    }
+  }
+  return QString();
+}
+
+static QByteArray GetRcloneCacheKey() {
+
+  QFileInfo rclone(GetRclone());
+  QFileInfo conf(GetRcloneConfPath());
+
+  QStringList key;
+  key << rclone.absoluteFilePath() << QString::number(rclone.size())
+      << QString::number(rclone.lastModified().toMSecsSinceEpoch());
+  if (conf.exists()) {
+    key << conf.absoluteFilePath()
+        << QString::number(conf.lastModified().toMSecsSinceEpoch());
+  }
+  key << GetDefaultOptionsList("defaultRcloneOptions");
+
+  return QCryptographicHash::hash(key.join('\n').toUtf8(),
+                                  QCryptographicHash::Sha1)
+      .toHex();
+}
+
+// first line of cache file is "#" followed by key it was created for
+QByteArray ReadRcloneCache(const QString &name, bool *fresh) {
+
+  *fresh = false;
+
+  QFile file(GetConfigDir().absoluteFilePath(name + ".cache"));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return QByteArray();
+  }
+  QByteArray content = file.readAll();
+  file.close();
+
+  if (!content.startsWith('#')) {
+    return content;
+  }
+
+  int lineEnd = content.indexOf('\n');
+  if (lineEnd == -1) {
+    return QByteArray();
+  }
+  *fresh = (content.mid(1, lineEnd - 1) == GetRcloneCacheKey());
+  return content.mid(lineEnd + 1);
+}
+
+void WriteRcloneCache(const QString &name, const QByteArray &output) {
+
+  QDir outputDir = GetConfigDir();
+  if (!outputDir.exists()) {
+    outputDir.mkpath(".");
+  }
+
+  QSaveFile file(outputDir.absoluteFilePath(name + ".cache"));
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write("#" + GetRcloneCacheKey() + "\n");
+    file.write(output);
+    file.commit();
+  }
+}
+
+bool IsRcloneConfEncrypted() {
+
+  QFile file(GetRcloneConfPath());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  bool encrypted = file.read(4096).contains("RCLONE_ENCRYPT_V0:");
+  file.close();
+  return encrypted;
+}
+
+// reserve free localhost port for transfer's rclone remote control
+int AcquireRcPort() {
+  auto settings = GetSettings();
+  int port = settings->value("Settings/rcPortStartTransfer", 50700).toInt();
+
+  for (; port < 65535; ++port) {
+    if (global.usedRcPorts.contains(port)) {
+      continue;
+    }
+    // make sure nothing else listens on it
+    QTcpServer probe;
+    if (probe.listen(QHostAddress::LocalHost, static_cast<quint16>(port))) {
+      probe.close();
+      global.usedRcPorts << port;
+      return port;
+    }
+  }
+  return 0;
+}
+
+void ReleaseRcPort(int port) { global.usedRcPorts.removeAll(port); }
+
+// random alphanumeric string used for --rc-user and --rc-pass
+QString GenerateRcCredential(int length) {
+  const QString possibleCharacters(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
+
+  QString credential;
+  for (int i = 0; i < length; ++i) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 1)
+    int index =
+        QRandomGenerator::global()->generate() % possibleCharacters.length();
+#else
+    int index = qrand() % possibleCharacters.length();
+#endif
+    credential.append(possibleCharacters.at(index));
+  }
+  return credential;
+}
+
+// convert size as printed in rclone stats (e.g. "1.234 GiB", "1.234M",
+// "12 kBytes") to bytes
+qint64 ParseRcloneSize(const QString &size) {
+  QRegExp rxNumber(R"(^\s*([0-9.]+)\s*(\S?).*$)");
+
+  if (!rxNumber.exactMatch(size)) {
+    return 0;
+  }
+
+  double value = rxNumber.cap(1).toDouble();
+  int power = 0;
+  if (!rxNumber.cap(2).isEmpty()) {
+    power = QString("KMGTPE").indexOf(rxNumber.cap(2).toUpper()) + 1;
+  }
+
+  for (int i = 0; i < power; ++i) {
+    value *= 1024;
+  }
+  return static_cast<qint64>(value);
+}
+
+// human readable size using binary units
+QString FormatSize(qint64 bytes) {
+  const QStringList units = {"B", "KiB", "MiB", "GiB", "TiB", "PiB"};
+
+  double value = bytes;
+  int unit = 0;
+  while (value >= 1024 && unit < units.count() - 1) {
+    value /= 1024;
+    ++unit;
+  }
+
+  if (unit == 0) {
+    return QString::number(bytes) + " " + units.at(0);
+  }
+  return QString::number(value, 'f', 2) + " " + units.at(unit);
+}
+
 // build rclone cmd string (used for info, e.g. to show rclone cmd in transfer
 // dialog)
 QStringList GetRcloneCmd(const QStringList &args) {
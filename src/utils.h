@@ -4,10 +4,19 @@
 
 std::unique_ptr<QSettings> GetSettings();
 
+// read only copy of all settings for code building rclone command lines,
+// it has to be reloaded after settings are changed
+typedef QHash<QString, QVariant> SettingsSnapshot;
+std::shared_ptr<const SettingsSnapshot> GetSettingsSnapshot();
+void ReloadSettingsSnapshot();
+
 void ReadSettings(QSettings *settings, QObject *widget);
 void WriteSettings(QSettings *settings, QObject *widget);
 
 bool IsPortableMode();
+// keep settings and all config files in dir instead of user's ones, has to
+// be set at start before anything reads them
+void SetConfigDirOverride(const QString &dir);
 
 QString GetRclone();
 void SetRclone(const QString &rclone);
@@ -18,11 +27,28 @@ void SetRcloneConf(const QString &rcloneConf);
 void UseRclonePassword(QProcess *process);
 void SetRclonePassword(const QString &rclonePassword);
 
+// options setting split into arguments, parsed once per settings change
 QStringList GetDefaultOptionsList(const QString &settingsOptions);
+QStringList SplitCommandLine(const QString &line);
 QStringList GetRemoteModeRcloneOptions();
 QStringList GetShowHidden();
+// themed qbutton_icons shared by all widgets, GUI thread only
+QIcon GetButtonIcon(const QString &name);
 QStringList GetRcloneCmd(const QStringList &args);
 
 QDir GetConfigDir(void);
 
+// output of rclone command kept in config folder, it is fresh only while
+// rclone binary, its config file and default options stay the same
+QByteArray ReadRcloneCache(const QString &name, bool *fresh);
+void WriteRcloneCache(const QString &name, const QByteArray &output);
+bool IsRcloneConfEncrypted();
+
+int AcquireRcPort();
+void ReleaseRcPort(int port);
+QString GenerateRcCredential(int length);
+
+qint64 ParseRcloneSize(const QString &size);
+QString FormatSize(qint64 bytes);
+
 unsigned int compareVersion(std::string, std::string);